@@ -0,0 +1,73 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef STANDARD_ROBOT_PP_ROS2__ATTITUDE_HISTORY_HPP_
+#define STANDARD_ROBOT_PP_ROS2__ATTITUDE_HISTORY_HPP_
+
+#include <cstdint>
+
+#include "standard_robot_pp_ros2/seqlock_ring.hpp"
+#include "tf2/LinearMath/Quaternion.h"
+
+namespace standard_robot_pp_ros2
+{
+
+/// @brief 最近一段时间的 IMU 姿态与云台关节角，支持按时间戳插值查询
+/// @note 时间戳为同步后的上位机时间 (ns)。写入仅在接收线程中进行，查询无锁，可在任意线程中调用。
+///       同一进程中的其他节点可通过 ProcessRegistry<AttitudeHistory>::find(<节点全名>) 获取
+class AttitudeHistory
+{
+public:
+  explicit AttitudeHistory(size_t capacity);
+
+  void pushOrientation(int64_t stamp_ns, const tf2::Quaternion & orientation);
+  void pushJoint(int64_t stamp_ns, double pitch, double yaw);
+
+  /// @brief 查询 stamp_ns 时刻的 IMU 姿态 (slerp 插值)
+  /// @return stamp_ns 不在缓冲区覆盖的时间范围内时返回 false
+  bool orientationAt(int64_t stamp_ns, tf2::Quaternion & orientation) const;
+
+  /// @brief 查询 stamp_ns 时刻的云台关节角 (线性插值，按最短角距离处理跨越 ±pi)
+  /// @return stamp_ns 不在缓冲区覆盖的时间范围内时返回 false
+  bool jointAt(int64_t stamp_ns, double & pitch, double & yaw) const;
+
+private:
+  struct OrientationSample
+  {
+    int64_t stamp_ns;
+    double x;
+    double y;
+    double z;
+    double w;
+  };
+
+  struct JointSample
+  {
+    int64_t stamp_ns;
+    double pitch;
+    double yaw;
+  };
+
+  /// @brief 从最新样本向前查找包围 stamp_ns 的两个样本
+  template <typename T>
+  static bool findBracket(
+    const SeqlockRing<T> & ring, int64_t stamp_ns, T & before, T & after, double & ratio);
+
+  SeqlockRing<OrientationSample> orientations_;
+  SeqlockRing<JointSample> joints_;
+};
+
+}  // namespace standard_robot_pp_ros2
+
+#endif  // STANDARD_ROBOT_PP_ROS2__ATTITUDE_HISTORY_HPP_
@@ -0,0 +1,80 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef STANDARD_ROBOT_PP_ROS2__CHANGE_DETECTOR_HPP_
+#define STANDARD_ROBOT_PP_ROS2__CHANGE_DETECTOR_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace standard_robot_pp_ros2
+{
+
+/// @brief 按数据段字节判断是否需要发布：内容变化时立即发布，未变化时按心跳周期重发
+/// @note 非线程安全，仅在接收线程中使用
+class ChangeDetector
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /// @param enabled 为 false 时每帧都发布
+  /// @param heartbeat 内容未变化时的最长发布间隔，为 0 时不重发
+  void configure(bool enabled, std::chrono::milliseconds heartbeat)
+  {
+    enabled_ = enabled;
+    heartbeat_ = heartbeat;
+    reset();
+  }
+
+  /// @brief 清除上次发布的内容，下一帧必定发布
+  void reset() { last_.clear(); }
+
+  bool enabled() const { return enabled_; }
+
+  template <typename T>
+  bool shouldPublish(const T & data, Clock::time_point now)
+  {
+    return shouldPublish(reinterpret_cast<const uint8_t *>(&data), sizeof(T), now);
+  }
+
+  bool shouldPublish(const uint8_t * data, size_t size, Clock::time_point now)
+  {
+    if (!enabled_) {
+      return true;
+    }
+
+    const bool changed = last_.size() != size || std::memcmp(last_.data(), data, size) != 0;
+    const bool heartbeat = heartbeat_.count() > 0 && now - last_publish_time_ >= heartbeat_;
+    if (!changed && !heartbeat) {
+      return false;
+    }
+
+    // 容量在首次发布后即固定，之后的 assign 不再分配内存
+    last_.assign(data, data + size);
+    last_publish_time_ = now;
+    return true;
+  }
+
+private:
+  bool enabled_ = false;
+  std::chrono::milliseconds heartbeat_{0};
+  std::vector<uint8_t> last_;
+  Clock::time_point last_publish_time_;
+};
+
+}  // namespace standard_robot_pp_ros2
+
+#endif  // STANDARD_ROBOT_PP_ROS2__CHANGE_DETECTOR_HPP_
@@ -0,0 +1,85 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef STANDARD_ROBOT_PP_ROS2__FIRE_SCHEDULER_HPP_
+#define STANDARD_ROBOT_PP_ROS2__FIRE_SCHEDULER_HPP_
+
+#include <cstdint>
+#include <limits>
+
+namespace standard_robot_pp_ros2
+{
+
+/// @brief 开火时机调度：在预计到达下位机的时刻达到目标时刻的那一帧，
+///        或预测瞄准误差首次小于阈值的那一帧开火
+/// @note 每次请求只开火一次，新请求覆盖未完成的请求。cmd_shoot 的直接指令也经由本类，
+///       只在没有调度中的请求时生效。非线程安全，由调用方加锁
+class FireScheduler
+{
+public:
+  static constexpr int64_t NO_WAKEUP = std::numeric_limits<int64_t>::max();
+
+  /// @brief 对本帧 fire 的处理
+  enum class Action {
+    NONE,  // 没有调度中的请求，fire 由 cmd_shoot 控制
+    HOLD,  // fire 置 0：等待开火时机，或上一帧为开火帧
+    FIRE,  // fire 置 1，只保持这一帧
+  };
+
+  /// @brief 请求在 fire_ns (上位机时间) 开火
+  void scheduleAt(int64_t fire_ns);
+
+  /// @brief 请求在预测瞄准误差小于 max_error (rad) 时开火，超过 expire_ns 仍未满足时放弃
+  void scheduleWhenAimed(double max_error, int64_t expire_ns);
+
+  /// @brief cmd_shoot 的直接指令，保持到下一条指令
+  void setManualFire(uint8_t fire);
+
+  void cancel() { mode_ = Mode::NONE; }
+
+  bool pending() const { return mode_ != Mode::NONE; }
+
+  /// @brief 本帧的 fire 值：nextFrame 返回 NONE 时为直接指令，否则按调度结果
+  uint8_t fireValue(Action action) const;
+
+  /// @brief 收到过任意开火指令或请求后保持打开摩擦轮
+  bool fricOn() const { return fric_on_; }
+
+  /// @brief 决定当前发送的帧如何设置 fire，开火后请求结束，下一帧清零
+  /// @param arrival_ns 本帧预计到达下位机的时刻 (上位机时间)，由调用方按下行延迟估计
+  /// @param tolerance_ns 定时请求允许提前的时间，吸收发送线程的唤醒抖动
+  /// @param aim_error 本帧的预测瞄准误差 (rad)，无法预测时为负
+  Action nextFrame(int64_t arrival_ns, int64_t tolerance_ns, double aim_error);
+
+  /// @brief 定时请求需要发送开火帧的上位机时刻，发送线程据此缩短休眠以对齐目标时刻
+  /// @return 没有定时请求时返回 NO_WAKEUP
+  int64_t wakeupNs(int64_t latency_ns) const;
+
+private:
+  enum class Mode { NONE, AT_TIME, WHEN_AIMED };
+
+  bool shouldFire(int64_t arrival_ns, int64_t tolerance_ns, double aim_error);
+
+  Mode mode_ = Mode::NONE;
+  int64_t fire_ns_ = 0;
+  int64_t expire_ns_ = 0;
+  double max_error_ = 0.0;
+  bool fired_ = false;  // 上一帧为开火帧
+  uint8_t manual_fire_ = 0;
+  bool fric_on_ = false;
+};
+
+}  // namespace standard_robot_pp_ros2
+
+#endif  // STANDARD_ROBOT_PP_ROS2__FIRE_SCHEDULER_HPP_
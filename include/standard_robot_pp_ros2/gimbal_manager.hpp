@@ -15,51 +15,161 @@
 #ifndef STANDARD_ROBOT_PP_ROS2__GIMBAL_MANAGER_HPP_
 #define STANDARD_ROBOT_PP_ROS2__GIMBAL_MANAGER_HPP_
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "example_interfaces/msg/float64_multi_array.hpp"
+#include "example_interfaces/srv/set_bool.hpp"
 #include "pb_rm_interfaces/msg/gimbal_cmd.hpp"
 #include "rclcpp/rclcpp.hpp"
 #include "sensor_msgs/msg/joint_state.hpp"
+#include "standard_robot_pp_ros2/gimbal_setpoint.hpp"
+#include "standard_robot_pp_ros2/realtime_utils.hpp"
+#include "standard_robot_pp_ros2/scan_pattern.hpp"
+#include "standard_robot_pp_ros2/seqlock_ring.hpp"
+#include "standard_robot_pp_ros2/trajectory_generator.hpp"
 
 namespace standard_robot_pp_ros2
 {
 
-enum class ControlMode { POSITION, VELOCITY };
+// SCAN 按配置的扫描波形运动，HOLD 停在当前位置
+enum class ControlMode : uint32_t { POSITION, VELOCITY, SCAN, HOLD };
 
-struct AxisControl
-{
-  ControlMode mode = ControlMode::POSITION;
-  float velocity = 0.0f;       // Desired velocity (rad/s)
-  float min_range = 0.0f;      // Minimum angle limit (rad)
-  float max_range = 0.0f;      // Maximum angle limit (rad)
-  bool is_continuous = false;  // Continuous rotation mode
-};
+#define MAX_GIMBAL_AXES 8
 
 class GimbalManagerNode : public rclcpp::Node
 {
 public:
   explicit GimbalManagerNode(const rclcpp::NodeOptions & options);
-  ~GimbalManagerNode() override = default;
+  ~GimbalManagerNode() override;
 
 private:
+  /// @brief 控制循环调度抖动统计，每秒发布一次后清零
+  struct LoopStats
+  {
+    uint64_t count = 0;
+    uint64_t overruns = 0;  // 错过的周期数
+    double jitter_sum_us = 0.0;
+    double jitter_sq_sum_us = 0.0;
+    double jitter_max_us = 0.0;
+  };
+
+  /// @brief 单轴命令，seq 在该轴收到不同的命令时加一
+  struct AxisCommand
+  {
+    uint32_t seq;
+    ControlMode mode;
+    float target;     // POSITION 的目标角度 (rad)
+    float velocity;   // VELOCITY 的速度 (rad/s)
+    float min_range;  // VELOCITY 的角度范围 (rad)
+    float max_range;
+  };
+
+  /// @brief 所有轴的命令，由订阅回调整体写入命令槽位、控制线程读取
+  struct AxisCommands
+  {
+    AxisCommand axes[MAX_GIMBAL_AXES];
+  };
+
+  /// @brief 各轴状态按字段连续存储 (structure of arrays)，速度模式的积分可对所有轴向量化
+  struct AxisStates
+  {
+    std::vector<double> position;  // 发送给下位机的设定值 (rad)
+    std::vector<double> target;    // POSITION 命令的目标角度 (rad)
+    std::vector<double> velocity;  // VELOCITY 命令的速度 (rad/s)，到达范围边界时反向
+    std::vector<double> min_range;
+    std::vector<double> max_range;
+    std::vector<uint8_t> velocity_mode;
+    std::vector<uint8_t> continuous;  // 范围为 2*pi 时循环
+    std::vector<uint8_t> scan_mode;
+    std::vector<double> scan_phase;  // 扫描波形的相位累加器 (周期数)
+    std::vector<uint32_t> applied_seq;
+    std::vector<JerkLimitedTrajectory> trajectory;
+
+    void resize(size_t size);
+  };
+
+  void controlLoop();
+
+  void publishLoopStats(double elapsed);
+
+  template <typename T>
+  std::vector<T> declareAxisParameter(const std::string & name, T default_value);
+
   void gimbalCmdCallback(const pb_rm_interfaces::msg::GimbalCmd::SharedPtr msg);
 
+  void gimbalAxesCmdCallback(const sensor_msgs::msg::JointState::SharedPtr msg);
+
+  void scanCallback(
+    const example_interfaces::srv::SetBool::Request::SharedPtr request,
+    example_interfaces::srv::SetBool::Response::SharedPtr response);
+
+  void getScanParams();
+
+  /// @brief 在订阅回调中更新一个轴的待发布命令
+  /// @return 命令与该轴当前命令不同时返回 true
+  bool setAxisCommand(
+    size_t axis, ControlMode mode, float target, float velocity, float min_range,
+    float max_range);
+
+  /// @brief 在控制线程中应用命令槽位中各轴的新命令
+  void applyCommands();
+
   void updateState(double delta_time);
 
   void publishJointState();
 
-  double updateAxisPosition(double current, AxisControl & ctrl, double delta);
+  /// @brief 速度模式的各轴按速度积分，在范围边界处反向或循环
+  void updateAxisPositions(double delta);
 
-  struct
-  {
-    double pitch = 0.0;
-    double yaw = 0.0;
-    AxisControl pitch_ctrl;
-    AxisControl yaw_ctrl;
-    rclcpp::Time last_update;
-  } state_;
+  /// @brief 扫描模式的各轴推进相位并按波形求值
+  void updateAxisScans(double delta);
+
+  /// @brief 位置模式下沿轨迹逼近目标，速度与扫描模式下让轨迹跟随当前位置以便切换时连续
+  void updateAxisTrajectories(double delta);
+
+  size_t num_axes_;
+  std::vector<std::string> axis_names_;
+  // cmd_gimbal_axes 中速度命令的角度范围
+  std::vector<double> axis_min_range_;
+  std::vector<double> axis_max_range_;
+  std::vector<ScanPattern> scan_patterns_;
+  // GimbalCmd 的 pitch/yaw 对应的轴序号，快速通道也发送这两个轴
+  size_t pitch_axis_;
+  size_t yaw_axis_;
+
+  // 订阅回调是命令槽位唯一的写者，控制线程是 axes_ 唯一的访问者，因此无需加锁
+  SeqlockRing<AxisCommands> cmd_slot_;
+  AxisCommands pending_cmd_;  // 仅由订阅回调访问
+  uint64_t applied_cmd_count_;
+  AxisStates axes_;
+
+  // 为 false 时位置命令直接跳变到目标角度
+  bool trajectory_enable_;
+
+  double loop_rate_;  // (Hz)
+  ThreadRtConfig control_thread_config_;
+  std::thread control_thread_;
+  std::atomic<bool> stop_requested_;
+  LoopStats loop_stats_;
+
+  // 与串口节点组合运行时的进程内快速通道
+  std::shared_ptr<GimbalSetpointSlot> setpoint_slot_;
 
+  // 订阅使用同一个互斥回调组，多线程执行器下回调之间不会并发，保证命令槽位单写者
+  rclcpp::CallbackGroup::SharedPtr cmd_callback_group_;
   rclcpp::Subscription<pb_rm_interfaces::msg::GimbalCmd>::SharedPtr cmd_sub_;
+  rclcpp::Subscription<sensor_msgs::msg::JointState>::SharedPtr axes_cmd_sub_;
+  rclcpp::Service<example_interfaces::srv::SetBool>::SharedPtr scan_srv_;
   rclcpp::Publisher<sensor_msgs::msg::JointState>::SharedPtr joint_pub_;
-  rclcpp::TimerBase::SharedPtr timer_;
+  sensor_msgs::msg::JointState joint_msg_;  // 仅由控制线程访问
+  rclcpp::Publisher<example_interfaces::msg::Float64MultiArray>::SharedPtr loop_stats_pub_;
+  example_interfaces::msg::Float64MultiArray loop_stats_msg_;  // 仅由控制线程访问
 };
 }  // namespace standard_robot_pp_ros2
 
@@ -0,0 +1,41 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef STANDARD_ROBOT_PP_ROS2__GIMBAL_SETPOINT_HPP_
+#define STANDARD_ROBOT_PP_ROS2__GIMBAL_SETPOINT_HPP_
+
+#include <cstdint>
+
+#include "standard_robot_pp_ros2/seqlock_ring.hpp"
+
+namespace standard_robot_pp_ros2
+{
+
+/// @brief 云台管理节点交给串口节点的云台设定值
+struct GimbalSetpoint
+{
+  int64_t stamp_ns;  // 写入时刻 (ROS 时间)
+  double pitch;      // (rad)
+  double yaw;        // (rad)
+};
+
+/// @brief 组合运行时的进程内快速通道：云台管理节点以自身全名注册到 ProcessRegistry，
+///        串口节点在发送线程中直接读取最新设定值，不经过序列化与关节名匹配
+using GimbalSetpointSlot = SeqlockRing<GimbalSetpoint>;
+
+// 多留几个槽位，读者在写者连续写入时也不必反复重试
+constexpr size_t GIMBAL_SETPOINT_SLOT_CAPACITY = 4;
+
+}  // namespace standard_robot_pp_ros2
+
+#endif  // STANDARD_ROBOT_PP_ROS2__GIMBAL_SETPOINT_HPP_
@@ -0,0 +1,85 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef STANDARD_ROBOT_PP_ROS2__GIMBAL_SIMULATOR_HPP_
+#define STANDARD_ROBOT_PP_ROS2__GIMBAL_SIMULATOR_HPP_
+
+#include <cstdint>
+
+#include "standard_robot_pp_ros2/packet_typedef.hpp"
+
+namespace standard_robot_pp_ros2
+{
+
+/// @brief 云台仿真：代替下位机接收 SendRobotCmdData，输出 ReceiveJointState 与 ReceiveImuData 帧
+/// @note 每个轴为二阶系统 (下位机位置环的闭环响应)，加速度与速度受电机能力限制，
+///       关节角按编码器分辨率量化。非线程安全，仅在发送线程或测试中单线程使用
+class GimbalSimulator
+{
+public:
+  struct AxisConfig
+  {
+    double natural_frequency = 30.0;      // 闭环自然频率 (rad/s)
+    double damping = 0.8;                 // 阻尼比
+    double max_velocity = 20.0;           // (rad/s)
+    double max_acceleration = 300.0;      // (rad/s^2)
+    bool position_limited = true;         // false 时为可无限旋转的轴，忽略机械限位
+    double min_position = -0.6;           // 机械限位 (rad)
+    double max_position = 0.6;            // (rad)
+    double encoder_resolution = 7.67e-4;  // 编码器分辨率 (rad)，默认 13 位编码器
+  };
+
+  void configure(const AxisConfig & pitch, const AxisConfig & yaw);
+
+  /// @brief 状态清零，下位机时间戳从 time_stamp (ms) 开始
+  void reset(uint32_t time_stamp = 0);
+
+  /// @brief 以控制帧中的云台角度作为设定值
+  void setCommand(const SendRobotCmdData & cmd);
+
+  /// @brief 推进 dt 秒，内部按 1 ms 步长积分
+  void step(double dt);
+
+  /// @brief 生成带帧头与校验的关节角帧，关节角经编码器量化
+  ReceiveJointState jointState();
+
+  /// @brief 生成带帧头与校验的 IMU 帧，假设底盘静止，yaw 折回 [-pi, pi]
+  ReceiveImuData imuData();
+
+  uint32_t timeStamp() const;
+  double pitch() const { return pitch_.position; }
+  double yaw() const { return yaw_.position; }
+  double pitchSetpoint() const { return pitch_.setpoint; }
+  double yawSetpoint() const { return yaw_.setpoint; }
+
+private:
+  struct Axis
+  {
+    AxisConfig config;
+    double setpoint = 0.0;
+    double position = 0.0;
+    double velocity = 0.0;
+
+    void integrate(double dt);
+    double encoderPosition() const;
+  };
+
+  Axis pitch_;
+  Axis yaw_;
+  uint32_t start_time_stamp_ = 0;
+  double time_ = 0.0;  // (s)
+};
+
+}  // namespace standard_robot_pp_ros2
+
+#endif  // STANDARD_ROBOT_PP_ROS2__GIMBAL_SIMULATOR_HPP_
@@ -0,0 +1,74 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef STANDARD_ROBOT_PP_ROS2__MCU_CLOCK_HPP_
+#define STANDARD_ROBOT_PP_ROS2__MCU_CLOCK_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace standard_robot_pp_ros2
+{
+
+/// @brief 下位机时钟与上位机时钟的同步
+/// @note 对 (上位机接收时刻 - 下位机时间戳) 在滑动窗口内取最小值作为时钟偏移，
+///       即认为窗口内传输最快的一帧延迟为 base_latency。
+///       update() 仅在接收线程中调用，其余接口可在任意线程中调用
+class McuClock
+{
+public:
+  /// @param window 最小值滤波窗口，应大于传输延迟抖动的周期且远小于晶振漂移的时间尺度
+  /// @param base_latency 传输最快的一帧的单程延迟，需按链路标定
+  void configure(std::chrono::milliseconds window, std::chrono::nanoseconds base_latency);
+
+  /// @brief 清除同步状态，串口重连或下位机重启后调用
+  void reset();
+
+  /// @brief 用一帧数据更新同步状态
+  /// @param mcu_ms 帧内的下位机时间戳 (ms)
+  /// @param host_ns 上位机收到该帧的时刻 (ns)
+  void update(uint32_t mcu_ms, int64_t host_ns);
+
+  bool isSynced() const { return synced_.load(std::memory_order_acquire); }
+
+  /// @brief 将下位机时间戳转换为上位机时间 (ns)，未同步时返回 0
+  int64_t toHostNs(uint32_t mcu_ms) const;
+
+  /// @brief 名义链路延迟 (ns)：配置的 base_latency 加上接收方向的平均排队延迟
+  /// @note 仅凭单向时间戳无法测得单程延迟的绝对值，base_latency 是配置的常数，
+  ///       只有排队延迟 (相对窗口内最快一帧的超出量) 来自实测。发送方向的延迟未测量，
+  ///       使用者将其用于发送方向时应通过各自的额外延迟参数标定
+  int64_t nominalLatencyNs() const { return latency_ns_.load(std::memory_order_relaxed); }
+
+private:
+  int64_t window_ns_ = 5000000000;
+  int64_t base_latency_ns_ = 0;
+
+  // 仅由接收线程访问
+  bool has_last_ = false;
+  uint32_t last_mcu_ms_ = 0;
+  int64_t block_start_ns_ = 0;
+  int64_t current_min_ns_ = 0;
+  int64_t previous_min_ns_ = 0;
+  double excess_ns_ = 0.0;
+
+  std::atomic<bool> synced_{false};
+  std::atomic<int64_t> offset_ns_{0};
+  std::atomic<int64_t> latency_ns_{0};
+};
+
+}  // namespace standard_robot_pp_ros2
+
+#endif  // STANDARD_ROBOT_PP_ROS2__MCU_CLOCK_HPP_
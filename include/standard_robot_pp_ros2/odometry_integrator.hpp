@@ -0,0 +1,73 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef STANDARD_ROBOT_PP_ROS2__ODOMETRY_INTEGRATOR_HPP_
+#define STANDARD_ROBOT_PP_ROS2__ODOMETRY_INTEGRATOR_HPP_
+
+#include <cstdint>
+
+namespace standard_robot_pp_ros2
+{
+
+/// @brief 平面里程计积分：底盘速度 (机体系) 融合 IMU 偏航角速度
+/// @note 以下位机时间戳计算积分步长，不受串口传输抖动影响。非线程安全，仅在接收线程中使用
+class OdometryIntegrator
+{
+public:
+  /// @param use_imu_yaw_rate 为 true 时优先使用 IMU 偏航角速度代替底盘反馈的 wz
+  /// @param imu_timeout_ms IMU 数据超过该时间未更新时退回使用底盘 wz
+  /// @param max_dt_ms 相邻两帧间隔超过该值时不积分，只重新开始计时
+  void configure(bool use_imu_yaw_rate, uint32_t imu_timeout_ms, uint32_t max_dt_ms);
+
+  /// @brief 位姿清零
+  void reset();
+
+  /// @brief 记录 IMU 偏航角速度 (rad/s)
+  void updateImu(uint32_t mcu_ms, double yaw_rate);
+
+  /// @brief 用底盘速度积分一步
+  /// @param vx, vy 机体系线速度 (m/s)
+  /// @param wz 底盘反馈的偏航角速度 (rad/s)
+  void updateMotion(uint32_t mcu_ms, double vx, double vy, double wz);
+
+  double x() const { return x_; }
+  double y() const { return y_; }
+  double yaw() const { return yaw_; }
+  double vx() const { return vx_; }
+  double vy() const { return vy_; }
+  double yawRate() const { return yaw_rate_; }
+
+private:
+  bool use_imu_yaw_rate_ = true;
+  uint32_t imu_timeout_ms_ = 20;
+  uint32_t max_dt_ms_ = 100;
+
+  bool has_imu_ = false;
+  uint32_t imu_ms_ = 0;
+  double imu_yaw_rate_ = 0.0;
+
+  bool has_motion_ = false;
+  uint32_t motion_ms_ = 0;
+
+  double x_ = 0.0;
+  double y_ = 0.0;
+  double yaw_ = 0.0;
+  double vx_ = 0.0;
+  double vy_ = 0.0;
+  double yaw_rate_ = 0.0;
+};
+
+}  // namespace standard_robot_pp_ros2
+
+#endif  // STANDARD_ROBOT_PP_ROS2__ODOMETRY_INTEGRATOR_HPP_
@@ -16,6 +16,7 @@
 #define STANDARD_ROBOT_PP_ROS2__PACKET_TYPEDEF_HPP_
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -38,11 +39,13 @@ const uint8_t ID_RFID_STATUS = 0x0A;
 const uint8_t ID_ROBOT_STATUS = 0x0B;
 const uint8_t ID_JOINT_STATE = 0x0C;
 const uint8_t ID_BUFF = 0x0D;
+const uint8_t ID_IMU_RAW = 0x0E;
 // Send
 const uint8_t ID_ROBOT_CMD = 0x01;
 
 const uint8_t DEBUG_PACKAGE_NUM = 10;
 const uint8_t DEBUG_PACKAGE_NAME_LEN = 10;
+const uint8_t IMU_RAW_BATCH_SIZE = 8;
 
 struct HeaderFrame
 {
@@ -95,6 +98,32 @@ struct ReceiveImuData
   uint16_t crc;
 } __attribute__((packed));
 
+// IMU 原始数据包，每帧合并多个连续采样以分摊帧头与校验开销
+struct ReceiveImuRawData
+{
+  HeaderFrame frame_header;
+  uint32_t time_stamp;  // 第一个采样的时间戳
+
+  struct
+  {
+    uint8_t sample_num;          // 本帧有效采样数，不超过 IMU_RAW_BATCH_SIZE
+    uint16_t sample_period_us;  // 相邻采样间隔
+
+    struct
+    {
+      float gyro_x;  // rad/s
+      float gyro_y;  // rad/s
+      float gyro_z;  // rad/s
+
+      float accel_x;  // m/s^2
+      float accel_y;  // m/s^2
+      float accel_z;  // m/s^2
+    } __attribute__((packed)) samples[IMU_RAW_BATCH_SIZE];
+  } __attribute__((packed)) data;
+
+  uint16_t crc;
+} __attribute__((packed));
+
 // 机器人信息数据包
 struct ReceiveRobotInfoData
 {
@@ -419,6 +448,14 @@ inline T fromVector(const std::vector<uint8_t> & data)
   return packet;
 }
 
+template <typename T>
+inline T fromBytes(const uint8_t * data, size_t len)
+{
+  T packet{};
+  std::copy(data, data + std::min(len, sizeof(T)), reinterpret_cast<uint8_t *>(&packet));
+  return packet;
+}
+
 template <typename T>
 inline std::vector<uint8_t> toVector(const T & data)
 {
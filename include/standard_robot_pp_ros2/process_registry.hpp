@@ -0,0 +1,68 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef STANDARD_ROBOT_PP_ROS2__PROCESS_REGISTRY_HPP_
+#define STANDARD_ROBOT_PP_ROS2__PROCESS_REGISTRY_HPP_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace standard_robot_pp_ros2
+{
+
+/// @brief 进程内对象注册表，供同一进程中组合运行的节点按名称共享对象
+/// @note 注册表只保存 weak_ptr，对象的生命周期由注册方管理
+template <typename T>
+class ProcessRegistry
+{
+public:
+  static void add(const std::string & key, const std::shared_ptr<T> & value)
+  {
+    std::lock_guard<std::mutex> lock(mutex());
+    entries()[key] = value;
+  }
+
+  static void remove(const std::string & key)
+  {
+    std::lock_guard<std::mutex> lock(mutex());
+    entries().erase(key);
+  }
+
+  /// @brief 查找对象，未注册或已销毁时返回 nullptr
+  static std::shared_ptr<T> find(const std::string & key)
+  {
+    std::lock_guard<std::mutex> lock(mutex());
+    const auto it = entries().find(key);
+    return it == entries().end() ? nullptr : it->second.lock();
+  }
+
+private:
+  static std::mutex & mutex()
+  {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+  static std::map<std::string, std::weak_ptr<T>> & entries()
+  {
+    static std::map<std::string, std::weak_ptr<T>> entries;
+    return entries;
+  }
+};
+
+}  // namespace standard_robot_pp_ros2
+
+#endif  // STANDARD_ROBOT_PP_ROS2__PROCESS_REGISTRY_HPP_
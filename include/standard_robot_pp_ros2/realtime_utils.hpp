@@ -0,0 +1,60 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef STANDARD_ROBOT_PP_ROS2__REALTIME_UTILS_HPP_
+#define STANDARD_ROBOT_PP_ROS2__REALTIME_UTILS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace standard_robot_pp_ros2
+{
+
+/// @brief 线程实时性配置
+struct ThreadRtConfig
+{
+  std::vector<int64_t> cpu_affinity;   // 绑定的 CPU 核心编号，为空时不绑定
+  std::string sched_policy = "other";  // 调度策略：other, fifo, rr
+  int sched_priority = 0;              // fifo/rr 下的实时优先级
+};
+
+/// @brief 检查调度策略名称是否合法
+bool isValidSchedPolicy(const std::string & policy);
+
+/// @brief 为调用线程设置线程名、CPU 亲和性与调度策略
+/// @param name 线程名（最长 15 个字符，超出部分截断）
+/// @param config 实时性配置
+/// @param error 设置失败时写入失败原因，多项失败以 "; " 分隔
+/// @return 全部设置成功时返回 true
+bool applyThreadRtConfig(
+  const std::string & name, const ThreadRtConfig & config, std::string & error);
+
+/// @brief 锁定进程内存 (mlockall) 并预先触碰堆，避免运行时缺页
+/// @param heap_size 预分配并保留的堆大小 (byte)
+/// @param error 失败时写入失败原因
+/// @param already_locked 本进程之前已成功调用过时为 true，此次不做任何改动
+/// @return 成功时返回 true
+/// @note 作用于整个进程：内存锁定与 mallopt 同样影响同一容器中的所有组件
+bool lockAndPrefaultMemory(size_t heap_size, std::string & error, bool & already_locked);
+
+/// @brief 逐块写入调用线程的栈空间，使其预先映射到物理内存
+/// @param stack_size 预先触碰的栈大小 (byte)，需小于线程栈大小
+/// @note 每个线程的栈独立，需在各线程内调用
+void prefaultStack(size_t stack_size);
+
+}  // namespace standard_robot_pp_ros2
+
+#endif  // STANDARD_ROBOT_PP_ROS2__REALTIME_UTILS_HPP_
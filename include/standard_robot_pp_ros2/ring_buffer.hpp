@@ -0,0 +1,70 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef STANDARD_ROBOT_PP_ROS2__RING_BUFFER_HPP_
+#define STANDARD_ROBOT_PP_ROS2__RING_BUFFER_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace standard_robot_pp_ros2
+{
+
+/// @brief 固定容量环形缓冲区，写满后覆盖最旧的数据
+/// @note 非线程安全，由调用方加锁
+template <typename T>
+class RingBuffer
+{
+public:
+  explicit RingBuffer(size_t capacity = 0) : buffer_(capacity), head_(0), size_(0) {}
+
+  /// @brief 修改容量并清空数据
+  void reset(size_t capacity)
+  {
+    buffer_.assign(capacity, T());
+    head_ = 0;
+    size_ = 0;
+  }
+
+  void push(const T & value)
+  {
+    if (buffer_.empty()) {
+      return;
+    }
+    buffer_[head_] = value;
+    head_ = (head_ + 1) % buffer_.size();
+    if (size_ < buffer_.size()) {
+      size_++;
+    }
+  }
+
+  /// @brief 按时间顺序访问，0 为最旧的数据
+  const T & at(size_t index) const
+  {
+    return buffer_[(head_ + buffer_.size() - size_ + index) % buffer_.size()];
+  }
+
+  size_t size() const { return size_; }
+  size_t capacity() const { return buffer_.size(); }
+  bool empty() const { return size_ == 0; }
+
+private:
+  std::vector<T> buffer_;
+  size_t head_;
+  size_t size_;
+};
+
+}  // namespace standard_robot_pp_ros2
+
+#endif  // STANDARD_ROBOT_PP_ROS2__RING_BUFFER_HPP_
@@ -15,25 +15,35 @@
 #ifndef STANDARD_ROBOT_PP_ROS2__ROBOT_INFO_HPP_
 #define STANDARD_ROBOT_PP_ROS2__ROBOT_INFO_HPP_
 
-#include <map>
-#include <string>
+#include <cstddef>
+#include <cstdint>
 
 namespace standard_robot_pp_ros2
 {
-const int CHASSIS_MODEL_NUM = 5;
-const int GIMBAL_MODEL_NUM = 2;
-const int SHOOT_MODEL_NUM = 3;
-const int ARM_MODEL_NUM = 2;
-const int CUSTOM_CONTROLLER_MODEL_NUM = 2;
+constexpr int CHASSIS_MODEL_NUM = 5;
+constexpr int GIMBAL_MODEL_NUM = 2;
+constexpr int SHOOT_MODEL_NUM = 3;
+constexpr int ARM_MODEL_NUM = 2;
+constexpr int CUSTOM_CONTROLLER_MODEL_NUM = 2;
 
-struct RobotModels
+// 按型号 id 索引的型号名称表
+constexpr const char * CHASSIS_MODELS[CHASSIS_MODEL_NUM] = {
+  "无底盘", "麦轮底盘", "全向轮底盘", "舵轮底盘", "平衡底盘"};
+constexpr const char * GIMBAL_MODELS[GIMBAL_MODEL_NUM] = {"无云台", "yaw_pitch直连云台"};
+constexpr const char * SHOOT_MODELS[SHOOT_MODEL_NUM] = {
+  "无发射机构", "摩擦轮+拨弹盘", "气动+拨弹盘"};
+constexpr const char * ARM_MODELS[ARM_MODEL_NUM] = {"无机械臂", "mini机械臂"};
+constexpr const char * CUSTOM_CONTROLLER_MODELS[CUSTOM_CONTROLLER_MODEL_NUM] = {
+  "无自定义控制器", "mini自定义控制器"};
+
+constexpr const char * UNKNOWN_MODEL = "未知型号";
+
+/// @brief 查找型号名称，id 超出范围时返回 UNKNOWN_MODEL
+template <size_t N>
+constexpr const char * modelName(const char * const (&models)[N], uint8_t id)
 {
-  std::map<uint8_t, std::string> chassis;
-  std::map<uint8_t, std::string> gimbal;
-  std::map<uint8_t, std::string> shoot;
-  std::map<uint8_t, std::string> arm;
-  std::map<uint8_t, std::string> custom_controller;
-};
+  return id < N ? models[id] : UNKNOWN_MODEL;
+}
 
 }  // namespace standard_robot_pp_ros2
 
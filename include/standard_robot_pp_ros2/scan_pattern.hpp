@@ -0,0 +1,67 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef STANDARD_ROBOT_PP_ROS2__SCAN_PATTERN_HPP_
+#define STANDARD_ROBOT_PP_ROS2__SCAN_PATTERN_HPP_
+
+#include <string>
+
+namespace standard_robot_pp_ros2
+{
+
+/// @brief 单轴周期扫描波形，以相位 (周期数，[0, 1)) 闭式求值
+/// @note 多轴组合可得到常用的搜索轨迹：
+///       - Lissajous：两轴均为 sine，频率取不同的比值，并设置相位差
+///       - 光栅：快轴为 triangle，慢轴为 staircase 且频率为快轴的 1/(steps-1)，
+///         慢轴恰好在快轴每次到达边界时换行
+class ScanPattern
+{
+public:
+  enum class Type { NONE, SINE, TRIANGLE, STAIRCASE };
+
+  struct Config
+  {
+    Type type = Type::NONE;
+    double frequency = 0.0;  // (Hz)
+    double phase = 0.0;      // 起始相位 (周期数)
+    double min = 0.0;        // (rad)
+    double max = 0.0;        // (rad)
+    double dwell = 0.0;      // triangle 在两端各停留的时间占周期的比例之和，[0, 1)
+    int steps = 2;           // staircase 的档位数
+  };
+
+  /// @return 名称无效时返回 false，可选 none, sine, triangle, staircase
+  static bool parseType(const std::string & name, Type & type);
+
+  void configure(const Config & config) { config_ = config; }
+
+  const Config & config() const { return config_; }
+
+  bool enabled() const { return config_.type != Type::NONE; }
+
+  /// @brief 将相位按频率推进 dt 秒并折回 [0, 1)
+  double advance(double phase, double dt) const;
+
+  /// @brief 计算相位对应的角度
+  double evaluate(double phase) const;
+
+private:
+  Config config_;
+};
+
+/// @brief 查表计算 sin(2*pi*phase)，相位以周期数表示，表间线性插值
+double sinCycles(double phase);
+
+}  // namespace standard_robot_pp_ros2
+
+#endif  // STANDARD_ROBOT_PP_ROS2__SCAN_PATTERN_HPP_
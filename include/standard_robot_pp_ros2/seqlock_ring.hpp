@@ -0,0 +1,118 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef STANDARD_ROBOT_PP_ROS2__SEQLOCK_RING_HPP_
+#define STANDARD_ROBOT_PP_ROS2__SEQLOCK_RING_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace standard_robot_pp_ros2
+{
+
+/// @brief 单写多读的无锁环形缓冲区，写满后覆盖最旧的数据
+/// @note 每个槽位使用序号 (seqlock) 保护，读者在数据被覆盖时读取失败而不会阻塞写者
+template <typename T>
+class SeqlockRing
+{
+  static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+  static_assert(sizeof(T) % sizeof(uint64_t) == 0, "sizeof(T) must be a multiple of 8");
+
+  static constexpr size_t kWords = sizeof(T) / sizeof(uint64_t);
+
+  struct Slot
+  {
+    std::atomic<uint64_t> seq{0};
+    std::atomic<uint64_t> words[kWords];
+  };
+
+public:
+  explicit SeqlockRing(size_t capacity)
+  : slots_(new Slot[capacity == 0 ? 1 : capacity]), capacity_(capacity == 0 ? 1 : capacity)
+  {
+  }
+
+  size_t capacity() const { return capacity_; }
+
+  /// @brief 已写入的样本总数，最新样本的序号为 count() - 1
+  uint64_t count() const { return count_.load(std::memory_order_acquire); }
+
+  /// @brief 写入一个样本，仅允许单个线程调用
+  void push(const T & value)
+  {
+    const uint64_t index = count_.load(std::memory_order_relaxed);
+    Slot & slot = slots_[index % capacity_];
+
+    uint64_t words[kWords];
+    std::memcpy(words, &value, sizeof(T));
+
+    slot.seq.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < kWords; i++) {
+      slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.seq.store(2 * index + 2, std::memory_order_release);
+    count_.store(index + 1, std::memory_order_release);
+  }
+
+  /// @brief 读取序号为 index 的样本
+  /// @return 样本尚未写入、已被覆盖或读取期间被改写时返回 false
+  bool read(uint64_t index, T & value) const
+  {
+    const Slot & slot = slots_[index % capacity_];
+    const uint64_t expected = 2 * index + 2;
+
+    if (slot.seq.load(std::memory_order_acquire) != expected) {
+      return false;
+    }
+    uint64_t words[kWords];
+    for (size_t i = 0; i < kWords; i++) {
+      words[i] = slot.words[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.seq.load(std::memory_order_relaxed) != expected) {
+      return false;
+    }
+
+    std::memcpy(&value, words, sizeof(T));
+    return true;
+  }
+
+  /// @brief 读取最新的样本，读取期间被改写时重试
+  /// @return 尚未写入任何样本时返回 false
+  bool readLatest(T & value) const
+  {
+    for (;;) {
+      const uint64_t count = this->count();
+      if (count == 0) {
+        return false;
+      }
+      if (read(count - 1, value)) {
+        return true;
+      }
+    }
+  }
+
+private:
+  std::unique_ptr<Slot[]> slots_;
+  size_t capacity_;
+  std::atomic<uint64_t> count_{0};
+};
+
+}  // namespace standard_robot_pp_ros2
+
+#endif  // STANDARD_ROBOT_PP_ROS2__SEQLOCK_RING_HPP_
@@ -16,13 +16,25 @@
 #define STANDARD_ROBOT_PP_ROS2__STANDARD_ROBOT_PP_ROS2_HPP_
 
 #include <auto_aim_interfaces/msg/detail/target__struct.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
+#include "builtin_interfaces/msg/time.hpp"
 #include "example_interfaces/msg/float64.hpp"
+#include "example_interfaces/msg/float64_multi_array.hpp"
 #include "example_interfaces/msg/u_int8.hpp"
+#include "example_interfaces/srv/trigger.hpp"
 #include "geometry_msgs/msg/twist.hpp"
+#include "lifecycle_msgs/msg/state.hpp"
+#include "nav_msgs/msg/odometry.hpp"
 #include "pb_rm_interfaces/msg/buff.hpp"
 #include "pb_rm_interfaces/msg/event_data.hpp"
 #include "pb_rm_interfaces/msg/game_robot_hp.hpp"
@@ -32,69 +44,350 @@
 #include "pb_rm_interfaces/msg/robot_state_info.hpp"
 #include "pb_rm_interfaces/msg/robot_status.hpp"
 #include "rclcpp/rclcpp.hpp"
+#include "rclcpp_lifecycle/lifecycle_node.hpp"
 #include "sensor_msgs/msg/imu.hpp"
 #include "sensor_msgs/msg/joint_state.hpp"
 #include "serial_driver/serial_driver.hpp"
+#include "std_msgs/msg/string.hpp"
+#include "standard_robot_pp_ros2/attitude_history.hpp"
+#include "standard_robot_pp_ros2/change_detector.hpp"
+#include "standard_robot_pp_ros2/fire_scheduler.hpp"
+#include "standard_robot_pp_ros2/gimbal_setpoint.hpp"
+#include "standard_robot_pp_ros2/gimbal_simulator.hpp"
+#include "standard_robot_pp_ros2/mcu_clock.hpp"
+#include "standard_robot_pp_ros2/odometry_integrator.hpp"
 #include "standard_robot_pp_ros2/packet_typedef.hpp"
+#include "standard_robot_pp_ros2/process_registry.hpp"
+#include "standard_robot_pp_ros2/realtime_utils.hpp"
+#include "standard_robot_pp_ros2/ring_buffer.hpp"
 #include "standard_robot_pp_ros2/robot_info.hpp"
+#include "standard_robot_pp_ros2/srv/get_attitude.hpp"
+#include "standard_robot_pp_ros2/target_predictor.hpp"
+#include "standard_robot_pp_ros2/timed_join_thread.hpp"
+#include "standard_robot_pp_ros2/topic_qos.hpp"
+#include "tf2/LinearMath/Transform.h"
+#include "tf2_ros/buffer.h"
+#include "tf2_ros/transform_broadcaster.h"
+#include "tf2_ros/transform_listener.h"
+#include "urdf/model.h"
 #include "auto_aim_interfaces/msg/target.hpp"
 
 namespace standard_robot_pp_ros2
 {
-class StandardRobotPpRos2Node : public rclcpp::Node
+using FlowControl = drivers::serial_driver::FlowControl;
+using Parity = drivers::serial_driver::Parity;
+using StopBits = drivers::serial_driver::StopBits;
+using SerialPortConfig = drivers::serial_driver::SerialPortConfig;
+
+class StandardRobotPpRos2Node : public rclcpp_lifecycle::LifecycleNode
 {
 public:
+  using CallbackReturn = rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn;
+
   explicit StandardRobotPpRos2Node(const rclcpp::NodeOptions & options);
 
   ~StandardRobotPpRos2Node() override;
 
+  /// @brief 初始化串口、发布者与订阅者，并启动 I/O 线程
+  CallbackReturn on_configure(const rclcpp_lifecycle::State & state) override;
+  /// @brief 开始发布话题与发送控制指令
+  CallbackReturn on_activate(const rclcpp_lifecycle::State & state) override;
+  /// @brief 停止发布话题与发送控制指令，保持串口连接
+  CallbackReturn on_deactivate(const rclcpp_lifecycle::State & state) override;
+  /// @brief 停止 I/O 线程、关闭串口并释放发布者与订阅者
+  CallbackReturn on_cleanup(const rclcpp_lifecycle::State & state) override;
+  CallbackReturn on_shutdown(const rclcpp_lifecycle::State & state) override;
+
 private:
-  bool is_usb_ok_;
-  bool debug_;
+  std::atomic<bool> is_usb_ok_;
+  std::atomic<bool> is_active_;
+  bool autostart_;
+  std::atomic<bool> debug_;
+  bool debug_batched_;
   std::unique_ptr<IoContext> owned_ctx_;
   std::string device_name_;
-  std::unique_ptr<drivers::serial_driver::SerialPortConfig> device_config_;
+  std::unique_ptr<SerialPortConfig> device_config_;
   std::unique_ptr<drivers::serial_driver::SerialDriver> serial_driver_;
 
-  std::thread receive_thread_;
-  std::thread send_thread_;
-  std::thread serial_port_protect_thread_;
+  // 启动时按候选波特率依次统计有效帧头数量，选择最多者
+  bool baud_rate_auto_detect_;
+  std::vector<int64_t> baud_rate_candidates_;
+  std::chrono::milliseconds baud_rate_detect_window_;
+
+  // 运行时修改的串口参数，由保护线程在原地重新打开串口时应用
+  std::mutex link_config_mutex_;
+  std::string pending_device_name_;
+  std::unique_ptr<SerialPortConfig> pending_device_config_;
+  std::atomic<bool> reconfigure_requested_;
+  rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr
+    on_set_parameters_callback_handle_;
+
+  TimedJoinThread receive_thread_;
+  TimedJoinThread send_thread_;
+  TimedJoinThread serial_port_protect_thread_;
+
+  // 所有 I/O 线程共享的停止标志，析构时置位并唤醒等待中的线程
+  std::atomic<bool> stop_requested_;
+  std::mutex stop_mutex_;
+  std::condition_variable stop_cv_;
+  std::chrono::milliseconds shutdown_timeout_;
+
+  // 发送与打开/关闭串口互斥
+  std::mutex port_mutex_;
+
+  // 异步读取回调写入，接收线程取出解析
+  std::mutex rx_mutex_;
+  std::condition_variable rx_cv_;
+  std::vector<uint8_t> rx_buffer_;
+  std::chrono::steady_clock::time_point last_receive_time_;
+  int64_t last_receive_host_ns_;
+  uint64_t link_generation_;
+  std::chrono::milliseconds receive_timeout_;
+
+  // Real-time
+  ThreadRtConfig receive_thread_config_;
+  ThreadRtConfig send_thread_config_;
+  ThreadRtConfig protect_thread_config_;
+  bool lock_memory_;
+  int64_t prefault_heap_size_;
+  int64_t prefault_stack_size_;
 
   // Publish
-  rclcpp::Publisher<sensor_msgs::msg::Imu>::SharedPtr imu_pub_;
-  rclcpp::Publisher<pb_rm_interfaces::msg::RobotStateInfo>::SharedPtr robot_state_info_pub_;
-  rclcpp::Publisher<pb_rm_interfaces::msg::EventData>::SharedPtr event_data_pub_;
-  rclcpp::Publisher<pb_rm_interfaces::msg::GameRobotHP>::SharedPtr all_robot_hp_pub_;
-  rclcpp::Publisher<pb_rm_interfaces::msg::GameStatus>::SharedPtr game_status_pub_;
-  rclcpp::Publisher<geometry_msgs::msg::Twist>::SharedPtr robot_motion_pub_;
-  rclcpp::Publisher<pb_rm_interfaces::msg::GroundRobotPosition>::SharedPtr
+  rclcpp_lifecycle::LifecyclePublisher<sensor_msgs::msg::Imu>::SharedPtr imu_pub_;
+  rclcpp_lifecycle::LifecyclePublisher<pb_rm_interfaces::msg::RobotStateInfo>::SharedPtr
+    robot_state_info_pub_;
+  rclcpp_lifecycle::LifecyclePublisher<pb_rm_interfaces::msg::EventData>::SharedPtr
+    event_data_pub_;
+  rclcpp_lifecycle::LifecyclePublisher<pb_rm_interfaces::msg::GameRobotHP>::SharedPtr
+    all_robot_hp_pub_;
+  rclcpp_lifecycle::LifecyclePublisher<pb_rm_interfaces::msg::GameStatus>::SharedPtr
+    game_status_pub_;
+  rclcpp_lifecycle::LifecyclePublisher<geometry_msgs::msg::Twist>::SharedPtr robot_motion_pub_;
+  rclcpp_lifecycle::LifecyclePublisher<pb_rm_interfaces::msg::GroundRobotPosition>::SharedPtr
     ground_robot_position_pub_;
-  rclcpp::Publisher<pb_rm_interfaces::msg::RfidStatus>::SharedPtr rfid_status_pub_;
-  rclcpp::Publisher<pb_rm_interfaces::msg::RobotStatus>::SharedPtr robot_status_pub_;
-  rclcpp::Publisher<sensor_msgs::msg::JointState>::SharedPtr joint_state_pub_;
-  rclcpp::Publisher<pb_rm_interfaces::msg::Buff>::SharedPtr buff_pub_;
+  rclcpp_lifecycle::LifecyclePublisher<pb_rm_interfaces::msg::RfidStatus>::SharedPtr
+    rfid_status_pub_;
+  rclcpp_lifecycle::LifecyclePublisher<pb_rm_interfaces::msg::RobotStatus>::SharedPtr
+    robot_status_pub_;
+  rclcpp_lifecycle::LifecyclePublisher<sensor_msgs::msg::JointState>::SharedPtr joint_state_pub_;
+  sensor_msgs::msg::JointState joint_state_msg_;  // 复用的消息模板
+  rclcpp_lifecycle::LifecyclePublisher<pb_rm_interfaces::msg::Buff>::SharedPtr buff_pub_;
 
   // Subscribe
   rclcpp::Subscription<geometry_msgs::msg::Twist>::SharedPtr cmd_vel_sub_;
   rclcpp::Subscription<sensor_msgs::msg::JointState>::SharedPtr cmd_gimbal_joint_sub_;
   rclcpp::Subscription<example_interfaces::msg::UInt8>::SharedPtr cmd_shoot_sub_;
   rclcpp::Subscription<auto_aim_interfaces::msg::Target>::SharedPtr cmd_tracking_sub_;
+  rclcpp::Subscription<builtin_interfaces::msg::Time>::SharedPtr cmd_shoot_at_sub_;
+  rclcpp::Subscription<example_interfaces::msg::Float64>::SharedPtr cmd_shoot_when_aimed_sub_;
 
-  RobotModels robot_models_;
-  std::unordered_map<std::string, rclcpp::Publisher<example_interfaces::msg::Float64>::SharedPtr>
+  std::unordered_map<
+    std::string, rclcpp_lifecycle::LifecyclePublisher<example_interfaces::msg::Float64>::SharedPtr>
     debug_pub_map_;
 
-  SendRobotCmdData send_robot_cmd_data_;
+  // 每个 debug 包槽位缓存的通道名与发布者
+  struct DebugChannel
+  {
+    std::array<uint8_t, DEBUG_PACKAGE_NAME_LEN> name_bytes{};
+    std::string name;
+    rclcpp_lifecycle::LifecyclePublisher<example_interfaces::msg::Float64>::SharedPtr publisher;
+  };
+  std::array<DebugChannel, DEBUG_PACKAGE_NUM> debug_channels_;
+
+  // 批量模式：每帧 ReceiveDebugData 合并为一条带下位机时间戳的消息
+  rclcpp_lifecycle::LifecyclePublisher<example_interfaces::msg::Float64MultiArray>::SharedPtr
+    debug_batch_pub_;
+  example_interfaces::msg::Float64MultiArray debug_batch_msg_;
+  bool debug_batch_names_changed_;
+
+  // 下位机时钟同步与按时间戳查询的姿态历史
+  McuClock mcu_clock_;
+  int attitude_history_size_;
+  std::shared_ptr<AttitudeHistory> attitude_history_;
+
+  // 直接广播云台关节 TF，关节原点与转轴取自 robot_description
+  struct GimbalJoint
+  {
+    std::string parent_frame;
+    std::string child_frame;
+    tf2::Transform origin;
+    tf2::Vector3 axis;
+  };
+  using GimbalJoints = std::array<GimbalJoint, 2>;  // pitch, yaw
+  bool gimbal_tf_enable_;
+  std::string gimbal_pitch_joint_;
+  std::string gimbal_yaw_joint_;
+  std::shared_ptr<const GimbalJoints> gimbal_joints_;  // 通过 std::atomic_load/store 访问
+  std::unique_ptr<tf2_ros::TransformBroadcaster> tf_broadcaster_;
+  std::vector<geometry_msgs::msg::TransformStamped> gimbal_tf_msgs_;
+  rclcpp::Subscription<std_msgs::msg::String>::SharedPtr robot_description_sub_;
+
+  // IMU：复用的消息模板与最近一次原始数据包中的加速度
+  sensor_msgs::msg::Imu imu_msg_;
+  sensor_msgs::msg::Imu imu_raw_msg_;
+  rclcpp_lifecycle::LifecyclePublisher<sensor_msgs::msg::Imu>::SharedPtr imu_raw_pub_;
+  Decimator imu_raw_decimator_;
+  bool has_imu_raw_;
+  uint32_t imu_raw_time_stamp_;
+  geometry_msgs::msg::Vector3 latest_accel_;
+
+  // 底盘速度与 IMU 偏航角速度积分的里程计
+  bool odometry_enable_;
+  bool odometry_publish_tf_;
+  OdometryIntegrator odometry_integrator_;
+  Decimator odometry_decimator_;
+  rclcpp_lifecycle::LifecyclePublisher<nav_msgs::msg::Odometry>::SharedPtr odometry_pub_;
+  nav_msgs::msg::Odometry odometry_msg_;
+  geometry_msgs::msg::TransformStamped odometry_tf_msg_;
+
+  // 与云台管理节点组合运行时，发送线程直接读取其设定值，设定值新鲜时覆盖 cmd_gimbal_joint 话题
+  bool gimbal_fast_path_enable_;
+  std::string gimbal_setpoint_key_;
+  std::chrono::nanoseconds gimbal_setpoint_timeout_;
+  std::shared_ptr<GimbalSetpointSlot> gimbal_setpoint_slot_;  // 仅由发送线程访问
+  std::chrono::steady_clock::time_point gimbal_setpoint_lookup_time_;
+
+  // 仿真模式：不打开串口，发送线程将控制帧交给云台仿真，仿真输出的帧经接收线程正常解析
+  bool simulation_enable_;
+  GimbalSimulator simulator_;                                // 受 port_mutex_ 保护
+  std::chrono::steady_clock::time_point simulation_time_;  // 受 port_mutex_ 保护
+
+  // 自瞄目标预测：跟踪回调只保存目标状态，发送线程按发送频率外推并写入云台指令
+  bool aim_enable_;
+  std::chrono::nanoseconds aim_target_timeout_;
+  std::chrono::nanoseconds aim_extra_delay_;
+  std::string aim_frame_id_;
+  std::unique_ptr<tf2_ros::Buffer> tf_buffer_;
+  std::unique_ptr<tf2_ros::TransformListener> tf_listener_;
+  TargetPredictor target_predictor_;
+  std::mutex target_mutex_;
+  TargetState target_state_;
+  bool aim_solution_valid_;  // 仅由发送线程访问
+  AimSolution aim_solution_;
+
+  // 开火调度：按下行延迟估计选择开火帧，只在该帧置位 fire
+  std::chrono::nanoseconds fire_aim_timeout_;
+  std::chrono::nanoseconds fire_extra_delay_;
+  std::mutex fire_mutex_;
+  FireScheduler fire_scheduler_;
+  // 最近一次关节反馈的 pitch/yaw (两个 float 合并存储，保证一致)，供发送线程计算瞄准误差
+  std::atomic<uint64_t> gimbal_feedback_;
+
+  // 各话题的 QoS 配置 (qos.<key>.*) 与降频
+  std::unordered_map<std::string, TopicQos> topic_qos_;
+  Decimator imu_decimator_;
+  Decimator robot_state_info_decimator_;
+  Decimator joint_state_decimator_;
+  Decimator robot_motion_decimator_;
+  Decimator event_data_decimator_;
+  Decimator all_robot_hp_decimator_;
+  Decimator game_status_decimator_;
+  Decimator ground_robot_position_decimator_;
+  Decimator rfid_status_decimator_;
+  Decimator robot_status_decimator_;
+  Decimator buff_decimator_;
+
+  // 状态类话题：仅在数据段变化或心跳到期时发布
+  ChangeDetector robot_state_info_change_;
+  ChangeDetector event_data_change_;
+  ChangeDetector all_robot_hp_change_;
+  ChangeDetector game_status_change_;
+  ChangeDetector rfid_status_change_;
+  ChangeDetector buff_change_;
+
+  // PID 调参：按抽取与批量参数发布，全速率样本保存在历史缓冲区中供服务导出
+  struct PidDebugSample
+  {
+    uint32_t time_stamp;
+    float fdb;
+    float ref;
+    float pid_out;
+  };
+  int pid_debug_decimation_;
+  int pid_debug_batch_size_;
+  int pid_debug_history_size_;
+  int pid_debug_sample_count_;
+  rclcpp_lifecycle::LifecyclePublisher<example_interfaces::msg::Float64MultiArray>::SharedPtr
+    pid_debug_pub_;
+  example_interfaces::msg::Float64MultiArray pid_debug_msg_;
+  std::mutex pid_debug_history_mutex_;
+  RingBuffer<PidDebugSample> pid_debug_history_;
+  rclcpp::Service<example_interfaces::srv::Trigger>::SharedPtr pid_debug_dump_srv_;
+  rclcpp::Service<srv::GetAttitude>::SharedPtr attitude_srv_;
+
+  // 随节点状态激活/停用的发布者
+  std::mutex managed_publishers_mutex_;
+  std::vector<std::shared_ptr<rclcpp_lifecycle::LifecyclePublisherInterface>> managed_publishers_;
+
+  // 话题回调只写入暂存的指令 (射击指令写入 fire_scheduler_)，发送线程每帧复制后叠加
+  // 快速通道、自瞄与开火调度，整帧只由发送线程填写与校验
+  std::mutex cmd_input_mutex_;
+  decltype(SendRobotCmdData::data) cmd_input_;
+  SendRobotCmdData send_robot_cmd_data_;  // 仅由发送线程访问
 
   void getParams();
+  rcl_interfaces::msg::SetParametersResult onSetParameters(
+    const std::vector<rclcpp::Parameter> & parameters);
+  bool takePendingLinkConfig();
+  ThreadRtConfig getThreadRtParams(const std::string & prefix);
+  GimbalSimulator::AxisConfig getSimulationAxisParams(const std::string & prefix);
+  void configureCurrentThread(const std::string & name, const ThreadRtConfig & config);
+  void lockMemory();
   void createPublisher();
   void createSubscription();
+  void createService();
+  void declareTopicQos(const std::string & key, const TopicQos & defaults, bool with_decimation);
+  rclcpp::QoS topicQos(const std::string & key) const;
+  void setPublishersActivated(bool activated);
+  void resetInterfaces();
+
+  template <typename MessageT>
+  std::shared_ptr<rclcpp_lifecycle::LifecyclePublisher<MessageT>> createManagedPublisher(
+    const std::string & topic_name, const rclcpp::QoS & qos)
+  {
+    auto publisher = create_publisher<MessageT>(topic_name, qos);
+    std::lock_guard<std::mutex> lock(managed_publishers_mutex_);
+    if (is_active_) {
+      publisher->on_activate();
+    }
+    managed_publishers_.push_back(publisher);
+    return publisher;
+  }
+
   void createNewDebugPublisher(const std::string & name);
+  void internDebugChannel(DebugChannel & channel, const uint8_t * name);
+  bool isRunning() const;
+  void sleepFor(std::chrono::nanoseconds duration);
+  void startThreads();
+  bool stopThreads();
+  bool threadsFinished() const;
+  bool openPort();
+  bool openPortLocked();
+  void closePort();
+  void reopenLink();
+  void detectBaudRate();
+  void onReceive(std::vector<uint8_t> & buffer, const size_t & bytes_transferred);
+  void processFrame(uint8_t id, const uint8_t * frame, size_t len);
   void receiveData();
   void sendData();
+  void simulateLink();
+  void updateGimbalFromSetpointSlot();
+  void updateAimCommand();
+  void updateFireCommand();
+  int64_t fireLatencyNs() const;
+  std::chrono::nanoseconds sendSleepDuration();
   void serialPortProtect();
 
   void publishDebugData(ReceiveDebugData & data);
+  void publishDebugBatch(ReceiveDebugData & data);
+  void publishPidDebugData(ReceivePidDebugData & data);
+  void dumpPidDebugHistory(
+    const example_interfaces::srv::Trigger::Request::SharedPtr request,
+    example_interfaces::srv::Trigger::Response::SharedPtr response);
+  void getAttitude(
+    const srv::GetAttitude::Request::SharedPtr request,
+    srv::GetAttitude::Response::SharedPtr response);
+  rclcpp::Time hostStamp(uint32_t mcu_ms);
   void publishImuData(ReceiveImuData & data);
   void publishRobotInfo(ReceiveRobotInfoData & data);
   void publishEventData(ReceiveEventData & data);
@@ -105,12 +398,21 @@ private:
   void publishRfidStatus(ReceiveRfidStatus & data);
   void publishRobotStatus(ReceiveRobotStatus & data);
   void publishJointState(ReceiveJointState & data);
+  void publishImuRawData(ReceiveImuRawData & data, size_t len);
+  void robotDescriptionCallback(const std_msgs::msg::String::SharedPtr msg);
+  void broadcastGimbalTf(const ReceiveJointState & joint_state, const rclcpp::Time & stamp);
+  void publishOdometry(uint32_t time_stamp);
   void publishBuff(ReceiveBuff & data);
 
   void cmdVelCallback(const geometry_msgs::msg::Twist::SharedPtr msg);
   void cmdGimbalJointCallback(const sensor_msgs::msg::JointState::SharedPtr msg);
   void cmdShootCallback(const example_interfaces::msg::UInt8::SharedPtr msg);
   void cmdTrakcingCallback(const auto_aim_interfaces::msg::Target::SharedPtr msg);
+  bool transformTargetToAimFrame(
+    const std::string & frame_id, const builtin_interfaces::msg::Time & stamp,
+    TargetState & target);
+  void cmdShootAtCallback(const builtin_interfaces::msg::Time::SharedPtr msg);
+  void cmdShootWhenAimedCallback(const example_interfaces::msg::Float64::SharedPtr msg);
 
   float last_hp_;
 };
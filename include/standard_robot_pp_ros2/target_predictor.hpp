@@ -0,0 +1,68 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef STANDARD_ROBOT_PP_ROS2__TARGET_PREDICTOR_HPP_
+#define STANDARD_ROBOT_PP_ROS2__TARGET_PREDICTOR_HPP_
+
+#include <cstdint>
+
+namespace standard_robot_pp_ros2
+{
+
+/// @brief 自瞄目标的运动学状态，字段含义与 auto_aim_interfaces/msg/Target 一致
+/// @note 位置与速度位于解算坐标系 (aim.frame_id)：原点为云台转动中心，x 为 yaw 零位方向、z 向上
+struct TargetState
+{
+  int64_t stamp_ns = 0;  // 观测时刻 (上位机时间)
+  bool tracking = false;
+  int armors_num = 0;
+  double x = 0.0, y = 0.0, z = 0.0;     // 旋转中心 (m)
+  double vx = 0.0, vy = 0.0, vz = 0.0;  // (m/s)
+  double yaw = 0.0;                     // 装甲板朝向 (rad)
+  double v_yaw = 0.0;                   // (rad/s)
+  double radius_1 = 0.0, radius_2 = 0.0;
+  double dz = 0.0;  // 另一组装甲板相对 z 的高度差 (m)
+};
+
+/// @brief 瞄准解算结果
+struct AimSolution
+{
+  double pitch;        // (rad)，按 REP-103 绕 y 轴为正，即向下为正
+  double yaw;          // (rad)
+  double flight_time;  // 弹丸飞行时间 (s)
+};
+
+/// @brief 按匀速与匀角速度模型外推目标，选择最正对的装甲板，并按重力弹道解算云台角度
+/// @note 无内部状态，可在任意线程中调用
+class TargetPredictor
+{
+public:
+  /// @param bullet_speed 弹丸初速 (m/s)
+  void configure(double bullet_speed) { bullet_speed_ = bullet_speed; }
+
+  /// @brief 外推 lead_time 加上弹丸飞行时间后解算瞄准角
+  /// @param lead_time 观测时刻到指令在下位机生效时刻的间隔 (s)
+  AimSolution solve(const TargetState & target, double lead_time) const;
+
+private:
+  /// @brief 计算击中 (distance, height) 所需的仰角 (向上为正) 与飞行时间，超出射程时直接瞄准
+  void solveBallistic(double distance, double height, double & elevation, double & flight_time)
+    const;
+
+  double bullet_speed_ = 25.0;
+  double gravity_ = 9.81;
+};
+
+}  // namespace standard_robot_pp_ros2
+
+#endif  // STANDARD_ROBOT_PP_ROS2__TARGET_PREDICTOR_HPP_
@@ -0,0 +1,105 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef STANDARD_ROBOT_PP_ROS2__TIMED_JOIN_THREAD_HPP_
+#define STANDARD_ROBOT_PP_ROS2__TIMED_JOIN_THREAD_HPP_
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace standard_robot_pp_ros2
+{
+
+/// @brief 可在限定时间内等待结束的线程
+/// @note 到达期限仍未结束的线程被分离，之后可通过 finished() 查询其是否已退出
+class TimedJoinThread
+{
+public:
+  TimedJoinThread() = default;
+  TimedJoinThread(const TimedJoinThread &) = delete;
+  TimedJoinThread & operator=(const TimedJoinThread &) = delete;
+  ~TimedJoinThread()
+  {
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  template <typename Function, typename... Args>
+  void start(Function && function, Args &&... args)
+  {
+    auto state = std::make_shared<State>();
+    state_ = state;
+    auto task = std::bind(std::forward<Function>(function), std::forward<Args>(args)...);
+    thread_ = std::thread([state, task]() mutable {
+      task();
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->finished = true;
+      state->cv.notify_all();
+    });
+  }
+
+  bool joinable() const { return thread_.joinable(); }
+
+  /// @brief 线程已退出（包括被分离后退出），未启动过的线程视为已退出
+  bool finished() const
+  {
+    if (!state_) {
+      return true;
+    }
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->finished;
+  }
+
+  /// @brief 等待线程结束直到 deadline，超时则分离线程
+  /// @return 线程在期限内结束并已 join 时返回 true
+  bool joinUntil(std::chrono::steady_clock::time_point deadline)
+  {
+    if (!thread_.joinable()) {
+      return true;
+    }
+
+    bool finished;
+    {
+      std::unique_lock<std::mutex> lock(state_->mutex);
+      finished = state_->cv.wait_until(lock, deadline, [this]() { return state_->finished; });
+    }
+    if (finished) {
+      thread_.join();
+    } else {
+      thread_.detach();
+    }
+    return finished;
+  }
+
+private:
+  struct State
+  {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool finished = false;
+  };
+
+  std::thread thread_;
+  std::shared_ptr<State> state_;
+};
+
+}  // namespace standard_robot_pp_ros2
+
+#endif  // STANDARD_ROBOT_PP_ROS2__TIMED_JOIN_THREAD_HPP_
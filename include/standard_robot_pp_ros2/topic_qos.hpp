@@ -0,0 +1,69 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef STANDARD_ROBOT_PP_ROS2__TOPIC_QOS_HPP_
+#define STANDARD_ROBOT_PP_ROS2__TOPIC_QOS_HPP_
+
+#include <string>
+
+#include "rclcpp/qos.hpp"
+
+namespace standard_robot_pp_ros2
+{
+
+/// @brief 单个话题的 QoS 与降频配置
+struct TopicQos
+{
+  std::string reliability = "reliable";  // reliable, best_effort
+  std::string durability = "volatile";   // volatile, transient_local
+  int depth = 10;                        // keep_last 深度
+  int decimation = 1;                    // 每 decimation 帧发布一次，仅用于发布者
+};
+
+/// @brief 检查配置是否合法
+/// @param error 不合法时写入原因
+bool isValidTopicQos(const TopicQos & config, std::string & error);
+
+/// @brief 将配置转换为 rclcpp::QoS
+rclcpp::QoS toQos(const TopicQos & config);
+
+/// @brief 按固定比例丢帧
+/// @note 非线程安全，仅在接收线程中使用
+class Decimator
+{
+public:
+  void configure(int decimation)
+  {
+    decimation_ = decimation;
+    count_ = 0;
+  }
+
+  /// @brief 返回本帧是否需要发布
+  bool tick()
+  {
+    if (++count_ < decimation_) {
+      return false;
+    }
+    count_ = 0;
+    return true;
+  }
+
+private:
+  int decimation_ = 1;
+  int count_ = 0;
+};
+
+}  // namespace standard_robot_pp_ros2
+
+#endif  // STANDARD_ROBOT_PP_ROS2__TOPIC_QOS_HPP_
@@ -0,0 +1,57 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef STANDARD_ROBOT_PP_ROS2__TRAJECTORY_GENERATOR_HPP_
+#define STANDARD_ROBOT_PP_ROS2__TRAJECTORY_GENERATOR_HPP_
+
+namespace standard_robot_pp_ros2
+{
+
+/// @brief 单轴速度、加速度、加加速度受限的在线轨迹生成
+/// @note 位置误差经开方控制器得到期望速度，速度误差经开方控制器得到期望加速度，
+///       加速度按加加速度上限逐步逼近期望值。每个周期都根据当前目标重新计算，
+///       新目标到达时无需重新规划，输出的位置、速度、加速度始终连续
+class JerkLimitedTrajectory
+{
+public:
+  struct Limits
+  {
+    double max_velocity;      // rad/s
+    double max_acceleration;  // rad/s^2
+    double max_jerk;          // rad/s^3
+  };
+
+  void setLimits(const Limits & limits) { limits_ = limits; }
+
+  /// @brief 将内部状态设置为给定位置与速度、加速度为 0，用于模式切换时保持连续
+  void reset(double position, double velocity = 0.0);
+
+  /// @brief 向目标位置推进一个周期
+  /// @return 本周期的位置设定值
+  double update(double target, double dt);
+
+  double position() const { return position_; }
+  double velocity() const { return velocity_; }
+  double acceleration() const { return acceleration_; }
+
+private:
+  Limits limits_{1.0, 1.0, 1.0};
+  double position_ = 0.0;
+  double velocity_ = 0.0;
+  double acceleration_ = 0.0;
+};
+
+}  // namespace standard_robot_pp_ros2
+
+#endif  // STANDARD_ROBOT_PP_ROS2__TRAJECTORY_GENERATOR_HPP_
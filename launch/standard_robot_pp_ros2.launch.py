@@ -13,22 +13,55 @@
 # limitations under the License.
 
 import os
+import tempfile
 
+import yaml
 from ament_index_python.packages import get_package_share_directory
 from launch import LaunchDescription
 from launch.actions import (
     DeclareLaunchArgument,
     GroupAction,
     IncludeLaunchDescription,
+    OpaqueFunction,
+    RegisterEventHandler,
     SetEnvironmentVariable,
 )
+from launch.conditions import IfCondition, UnlessCondition
+from launch.event_handlers import OnShutdown
 from launch.launch_description_sources import PythonLaunchDescriptionSource
 from launch.substitutions import LaunchConfiguration
-from launch_ros.actions import Node, PushRosNamespace, SetRemap
-from launch_ros.descriptions import ParameterFile
+from launch_ros.actions import ComposableNodeContainer, Node, PushRosNamespace, SetRemap
+from launch_ros.descriptions import ComposableNode, ParameterFile
 from nav2_common.launch import RewrittenYaml
 
 
+def rewrite_robot_description_params(params_file):
+    """gimbal_tf.enable 时云台 TF 由本节点直接广播，joint_state_publisher 不再发布云台关节"""
+    with open(params_file, "r") as f:
+        params = yaml.safe_load(f) or {}
+
+    node_params = params.get("standard_robot_pp_ros2", {}).get("ros__parameters", {})
+    gimbal_tf = node_params.get("gimbal_tf", {})
+    if not gimbal_tf.get("enable", node_params.get("gimbal_tf.enable", False)):
+        return params_file
+
+    # 去掉云台关节的来源，并且不为未收到的关节发布默认值，避免 TF 出现两个冲突的来源
+    jsp_params = params.setdefault("joint_state_publisher", {}).setdefault(
+        "ros__parameters", {}
+    )
+    jsp_params["source_list"] = [
+        source
+        for source in jsp_params.get("source_list", [])
+        if source != "serial/gimbal_joint_state"
+    ]
+    jsp_params["publish_default_positions"] = False
+
+    rewritten = tempfile.NamedTemporaryFile(mode="w", suffix=".yaml", delete=False)
+    with rewritten:
+        yaml.safe_dump(params, rewritten)
+    return rewritten.name
+
+
 def generate_launch_description():
     # Get the launch directory
     pkg_standard_robot_pp_ros2_dir = get_package_share_directory(
@@ -43,6 +76,7 @@ def generate_launch_description():
     params_file = LaunchConfiguration("params_file")
     robot_name = LaunchConfiguration("robot_name")
     use_rviz = LaunchConfiguration("use_rviz")
+    use_composition = LaunchConfiguration("use_composition")
     use_respawn = LaunchConfiguration("use_respawn")
     log_level = LaunchConfiguration("log_level")
 
@@ -89,22 +123,40 @@ def generate_launch_description():
         "use_rviz", default_value="False", description="Whether to start RViz"
     )
 
+    declare_use_composition_cmd = DeclareLaunchArgument(
+        "use_composition",
+        default_value="True",
+        description="Whether to run the serial and gimbal manager nodes in one process, "
+        "so that gimbal setpoints bypass the cmd_gimbal_joint topic",
+    )
+
     declare_use_respawn_cmd = DeclareLaunchArgument(
         "use_respawn",
         default_value="False",
-        description="Whether to respawn if a node crashes. Applied when composition is disabled.",
+        description="Whether to respawn if a node crashes. "
+        "With composition the whole container is respawned.",
     )
 
     declare_log_level_cmd = DeclareLaunchArgument(
         "log_level", default_value="info", description="log level"
     )
 
-    # Specify the actions
-    bringup_cmd_group = GroupAction(
-        [
-            PushRosNamespace(namespace),
-            SetRemap("/tf", "tf"),
-            SetRemap("/tf_static", "tf_static"),
+    def launch_robot_description(context):
+        source_params_file = context.perform_substitution(params_file)
+        robot_description_params_file = rewrite_robot_description_params(
+            source_params_file
+        )
+        actions = []
+        if robot_description_params_file != source_params_file:
+            # 改写后的参数文件只在本次启动中使用，退出时删除
+            def remove_rewritten_params(event, context):
+                if os.path.exists(robot_description_params_file):
+                    os.remove(robot_description_params_file)
+
+            actions.append(
+                RegisterEventHandler(OnShutdown(on_shutdown=remove_rewritten_params))
+            )
+        return actions + [
             IncludeLaunchDescription(
                 PythonLaunchDescriptionSource(
                     os.path.join(
@@ -114,14 +166,24 @@ def generate_launch_description():
                     )
                 ),
                 launch_arguments={
-                    "params_file": params_file,
+                    "params_file": robot_description_params_file,
                     "robot_name": robot_name,
                     "use_rviz": use_rviz,
                     "use_respawn": use_respawn,
                     "log_level": log_level,
                 }.items(),
-            ),
+            )
+        ]
+
+    # Specify the actions
+    bringup_cmd_group = GroupAction(
+        [
+            PushRosNamespace(namespace),
+            SetRemap("/tf", "tf"),
+            SetRemap("/tf_static", "tf_static"),
+            OpaqueFunction(function=launch_robot_description),
             Node(
+                condition=UnlessCondition(use_composition),
                 package="standard_robot_pp_ros2",
                 executable="standard_robot_pp_ros2_node",
                 name="standard_robot_pp_ros2",
@@ -132,12 +194,42 @@ def generate_launch_description():
                 arguments=["--ros-args", "--log-level", log_level],
             ),
             Node(
+                condition=UnlessCondition(use_composition),
                 package="standard_robot_pp_ros2",
                 executable="gimbal_manager_node",
                 name="gimbal_manager",
                 output="screen",
                 respawn=use_respawn,
                 respawn_delay=2.0,
+                parameters=[configured_params],
+                arguments=["--ros-args", "--log-level", log_level],
+            ),
+            # 每个组件使用独立的执行器，与分别启动时的调度行为一致。
+            # 云台设定值经 ProcessRegistry 直接传递，不开启 intra-process 通信：
+            # Humble 不允许 transient_local 的发布者/订阅者使用 intra-process
+            ComposableNodeContainer(
+                condition=IfCondition(use_composition),
+                name="standard_robot_pp_ros2_container",
+                namespace="",
+                package="rclcpp_components",
+                executable="component_container_isolated",
+                output="screen",
+                respawn=use_respawn,
+                respawn_delay=2.0,
+                composable_node_descriptions=[
+                    ComposableNode(
+                        package="standard_robot_pp_ros2",
+                        plugin="standard_robot_pp_ros2::StandardRobotPpRos2Node",
+                        name="standard_robot_pp_ros2",
+                        parameters=[configured_params],
+                    ),
+                    ComposableNode(
+                        package="standard_robot_pp_ros2",
+                        plugin="standard_robot_pp_ros2::GimbalManagerNode",
+                        name="gimbal_manager",
+                        parameters=[configured_params],
+                    ),
+                ],
                 arguments=["--ros-args", "--log-level", log_level],
             ),
         ]
@@ -154,6 +246,7 @@ def generate_launch_description():
     ld.add_action(declare_params_file_cmd)
     ld.add_action(declare_robot_name_cmd)
     ld.add_action(declare_use_rviz_cmd)
+    ld.add_action(declare_use_composition_cmd)
     ld.add_action(declare_use_respawn_cmd)
     ld.add_action(declare_log_level_cmd)
 
@@ -0,0 +1,102 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "standard_robot_pp_ros2/attitude_history.hpp"
+
+#include <cmath>
+
+namespace standard_robot_pp_ros2
+{
+
+namespace
+{
+double interpolateAngle(double from, double to, double ratio)
+{
+  return from + std::remainder(to - from, 2.0 * M_PI) * ratio;
+}
+}  // namespace
+
+AttitudeHistory::AttitudeHistory(size_t capacity) : orientations_(capacity), joints_(capacity) {}
+
+void AttitudeHistory::pushOrientation(int64_t stamp_ns, const tf2::Quaternion & orientation)
+{
+  orientations_.push(
+    {stamp_ns, orientation.x(), orientation.y(), orientation.z(), orientation.w()});
+}
+
+void AttitudeHistory::pushJoint(int64_t stamp_ns, double pitch, double yaw)
+{
+  joints_.push({stamp_ns, pitch, yaw});
+}
+
+template <typename T>
+bool AttitudeHistory::findBracket(
+  const SeqlockRing<T> & ring, int64_t stamp_ns, T & before, T & after, double & ratio)
+{
+  const uint64_t count = ring.count();
+  if (count == 0 || !ring.read(count - 1, after) || stamp_ns > after.stamp_ns) {
+    return false;
+  }
+  if (stamp_ns == after.stamp_ns) {
+    before = after;
+    ratio = 0.0;
+    return true;
+  }
+
+  // 查询通常针对最近几十毫秒，从最新样本向前线性查找
+  for (uint64_t index = count - 1; index-- > 0;) {
+    if (!ring.read(index, before)) {
+      // 已被写者覆盖，说明 stamp_ns 早于缓冲区覆盖范围
+      return false;
+    }
+    if (before.stamp_ns <= stamp_ns) {
+      const int64_t span = after.stamp_ns - before.stamp_ns;
+      ratio = span > 0 ? static_cast<double>(stamp_ns - before.stamp_ns) / span : 0.0;
+      return true;
+    }
+    after = before;
+  }
+  return false;
+}
+
+bool AttitudeHistory::orientationAt(int64_t stamp_ns, tf2::Quaternion & orientation) const
+{
+  OrientationSample before{};
+  OrientationSample after{};
+  double ratio = 0.0;
+  if (!findBracket(orientations_, stamp_ns, before, after, ratio)) {
+    return false;
+  }
+
+  const tf2::Quaternion q0(before.x, before.y, before.z, before.w);
+  const tf2::Quaternion q1(after.x, after.y, after.z, after.w);
+  orientation = q0.slerp(q1, ratio);
+  return true;
+}
+
+bool AttitudeHistory::jointAt(int64_t stamp_ns, double & pitch, double & yaw) const
+{
+  JointSample before{};
+  JointSample after{};
+  double ratio = 0.0;
+  if (!findBracket(joints_, stamp_ns, before, after, ratio)) {
+    return false;
+  }
+
+  pitch = interpolateAngle(before.pitch, after.pitch, ratio);
+  yaw = interpolateAngle(before.yaw, after.yaw, ratio);
+  return true;
+}
+
+}  // namespace standard_robot_pp_ros2
@@ -0,0 +1,106 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "standard_robot_pp_ros2/fire_scheduler.hpp"
+
+namespace standard_robot_pp_ros2
+{
+
+constexpr int64_t FireScheduler::NO_WAKEUP;
+
+void FireScheduler::scheduleAt(int64_t fire_ns)
+{
+  mode_ = Mode::AT_TIME;
+  fire_ns_ = fire_ns;
+  fric_on_ = true;
+}
+
+void FireScheduler::scheduleWhenAimed(double max_error, int64_t expire_ns)
+{
+  mode_ = Mode::WHEN_AIMED;
+  max_error_ = max_error;
+  expire_ns_ = expire_ns;
+  fric_on_ = true;
+}
+
+void FireScheduler::setManualFire(uint8_t fire)
+{
+  manual_fire_ = fire;
+  fric_on_ = true;
+}
+
+uint8_t FireScheduler::fireValue(Action action) const
+{
+  switch (action) {
+    case Action::FIRE:
+      return 1;
+    case Action::HOLD:
+      return 0;
+    case Action::NONE:
+    default:
+      return manual_fire_;
+  }
+}
+
+FireScheduler::Action FireScheduler::nextFrame(
+  int64_t arrival_ns, int64_t tolerance_ns, double aim_error)
+{
+  // 开火帧之后的一帧总是清零，紧接着的新请求顺延到下一帧，保证每次请求只触发一次
+  if (fired_) {
+    fired_ = false;
+    return Action::HOLD;
+  }
+  if (!pending()) {
+    return Action::NONE;
+  }
+
+  fired_ = shouldFire(arrival_ns, tolerance_ns, aim_error);
+  return fired_ ? Action::FIRE : Action::HOLD;
+}
+
+bool FireScheduler::shouldFire(int64_t arrival_ns, int64_t tolerance_ns, double aim_error)
+{
+  switch (mode_) {
+    case Mode::AT_TIME:
+      // 目标时刻已过时在第一帧立即开火
+      if (arrival_ns + tolerance_ns < fire_ns_) {
+        return false;
+      }
+      break;
+
+    case Mode::WHEN_AIMED:
+      if (arrival_ns > expire_ns_) {
+        mode_ = Mode::NONE;
+        return false;
+      }
+      if (aim_error < 0.0 || aim_error > max_error_) {
+        return false;
+      }
+      break;
+
+    case Mode::NONE:
+    default:
+      return false;
+  }
+
+  mode_ = Mode::NONE;
+  return true;
+}
+
+int64_t FireScheduler::wakeupNs(int64_t latency_ns) const
+{
+  return mode_ == Mode::AT_TIME ? fire_ns_ - latency_ns : NO_WAKEUP;
+}
+
+}  // namespace standard_robot_pp_ros2
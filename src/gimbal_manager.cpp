@@ -14,114 +14,458 @@
 
 #include "standard_robot_pp_ros2/gimbal_manager.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "standard_robot_pp_ros2/process_registry.hpp"
+
+#define MAX_LOOP_RATE 1000.0  // (Hz)
+#define CMD_SLOT_SIZE 8
+#define CONTINUOUS_RANGE_TOLERANCE 0.01  // (rad)
 
 namespace standard_robot_pp_ros2
 {
 
 GimbalManagerNode::GimbalManagerNode(const rclcpp::NodeOptions & options)
-: Node("gimbal_manager", options)
+: Node("gimbal_manager", options),
+  cmd_slot_(CMD_SLOT_SIZE),
+  pending_cmd_{},
+  applied_cmd_count_(0),
+  stop_requested_(false)
 {
   RCLCPP_INFO(get_logger(), "Start GimbalManagerNode!");
 
+  loop_rate_ = declare_parameter("loop_rate", 100.0);
+  if (loop_rate_ <= 0.0 || loop_rate_ > MAX_LOOP_RATE) {
+    throw std::invalid_argument{"loop_rate must be in (0, 1000] Hz."};
+  }
+  control_thread_config_.cpu_affinity =
+    declare_parameter("control_thread.cpu_affinity", std::vector<int64_t>{});
+  control_thread_config_.sched_policy =
+    declare_parameter<std::string>("control_thread.sched_policy", "other");
+  control_thread_config_.sched_priority =
+    declare_parameter<int>("control_thread.sched_priority", 0);
+  if (!isValidSchedPolicy(control_thread_config_.sched_policy)) {
+    throw std::invalid_argument{"control_thread.sched_policy must be one of: other, fifo, rr."};
+  }
+
+  axis_names_ = declare_parameter<std::vector<std::string>>(
+    "axes.names", std::vector<std::string>{"gimbal_pitch_joint", "gimbal_yaw_joint"});
+  num_axes_ = axis_names_.size();
+  if (num_axes_ == 0 || num_axes_ > MAX_GIMBAL_AXES) {
+    throw std::invalid_argument{"axes.names must have 1 to 8 elements."};
+  }
+  axis_min_range_ = declareAxisParameter("axes.min_range", -M_PI);
+  axis_max_range_ = declareAxisParameter("axes.max_range", M_PI);
+  const int pitch_axis = declare_parameter<int>("cmd_gimbal.pitch_axis", 0);
+  const int yaw_axis = declare_parameter<int>("cmd_gimbal.yaw_axis", num_axes_ > 1 ? 1 : 0);
+  if (
+    pitch_axis < 0 || static_cast<size_t>(pitch_axis) >= num_axes_ || yaw_axis < 0 ||
+    static_cast<size_t>(yaw_axis) >= num_axes_) {
+    throw std::invalid_argument{"cmd_gimbal.pitch_axis and cmd_gimbal.yaw_axis out of range."};
+  }
+  pitch_axis_ = pitch_axis;
+  yaw_axis_ = yaw_axis;
+
+  axes_.resize(num_axes_);
+  getScanParams();
+  trajectory_enable_ = declare_parameter("trajectory.enable", false);
+  const auto max_velocity = declareAxisParameter("trajectory.max_velocity", 10.0);
+  const auto max_acceleration = declareAxisParameter("trajectory.max_acceleration", 40.0);
+  const auto max_jerk = declareAxisParameter("trajectory.max_jerk", 800.0);
+  for (size_t i = 0; i < num_axes_; i++) {
+    if (max_velocity[i] <= 0.0 || max_acceleration[i] <= 0.0 || max_jerk[i] <= 0.0) {
+      throw std::invalid_argument{
+        "trajectory.max_velocity, max_acceleration and max_jerk must be positive."};
+    }
+    axes_.trajectory[i].setLimits({max_velocity[i], max_acceleration[i], max_jerk[i]});
+  }
+
+  cmd_callback_group_ = create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+  rclcpp::SubscriptionOptions cmd_sub_options;
+  cmd_sub_options.callback_group = cmd_callback_group_;
   cmd_sub_ = this->create_subscription<pb_rm_interfaces::msg::GimbalCmd>(
     "cmd_gimbal", 10,
-    std::bind(&GimbalManagerNode::gimbalCmdCallback, this, std::placeholders::_1));
+    std::bind(&GimbalManagerNode::gimbalCmdCallback, this, std::placeholders::_1),
+    cmd_sub_options);
+  axes_cmd_sub_ = this->create_subscription<sensor_msgs::msg::JointState>(
+    "cmd_gimbal_axes", 10,
+    std::bind(&GimbalManagerNode::gimbalAxesCmdCallback, this, std::placeholders::_1),
+    cmd_sub_options);
+  scan_srv_ = create_service<example_interfaces::srv::SetBool>(
+    "~/scan",
+    std::bind(
+      &GimbalManagerNode::scanCallback, this, std::placeholders::_1, std::placeholders::_2),
+    rmw_qos_profile_services_default, cmd_callback_group_);
 
   joint_pub_ = create_publisher<sensor_msgs::msg::JointState>("cmd_gimbal_joint", 10);
+  // 关节名与数组长度固定，控制循环中只更新时间戳与关节角
+  joint_msg_.name = axis_names_;
+  joint_msg_.position.resize(num_axes_);
+  loop_stats_pub_ =
+    create_publisher<example_interfaces::msg::Float64MultiArray>("~/loop_stats", 10);
+  loop_stats_msg_.layout.dim.resize(1);
+  loop_stats_msg_.layout.dim[0].label =
+    "rate_hz,jitter_mean_us,jitter_std_us,jitter_max_us,overruns";
+  loop_stats_msg_.layout.dim[0].size = 5;
+  loop_stats_msg_.layout.dim[0].stride = 5;
+  loop_stats_msg_.data.resize(5);
+
+  setpoint_slot_ = std::make_shared<GimbalSetpointSlot>(GIMBAL_SETPOINT_SLOT_CAPACITY);
+  ProcessRegistry<GimbalSetpointSlot>::add(get_fully_qualified_name(), setpoint_slot_);
+
+  control_thread_ = std::thread(&GimbalManagerNode::controlLoop, this);
+}
+
+void GimbalManagerNode::AxisStates::resize(size_t size)
+{
+  position.assign(size, 0.0);
+  target.assign(size, 0.0);
+  velocity.assign(size, 0.0);
+  min_range.assign(size, 0.0);
+  max_range.assign(size, 0.0);
+  velocity_mode.assign(size, 0);
+  continuous.assign(size, 0);
+  applied_seq.assign(size, 0);
+  scan_mode.assign(size, 0);
+  scan_phase.assign(size, 0.0);
+  trajectory.assign(size, JerkLimitedTrajectory());
+}
+
+template <typename T>
+std::vector<T> GimbalManagerNode::declareAxisParameter(const std::string & name, T default_value)
+{
+  // 只有一个元素时所有轴共用
+  auto values = declare_parameter<std::vector<T>>(name, std::vector<T>{default_value});
+  if (values.size() == 1) {
+    values.assign(num_axes_, values[0]);
+  }
+  if (values.size() != num_axes_) {
+    throw std::invalid_argument{name + " must have 1 element or one per axis."};
+  }
+  return values;
+}
+
+GimbalManagerNode::~GimbalManagerNode()
+{
+  stop_requested_ = true;
+  if (control_thread_.joinable()) {
+    control_thread_.join();
+  }
+  ProcessRegistry<GimbalSetpointSlot>::remove(get_fully_qualified_name());
+}
+
+void GimbalManagerNode::controlLoop()
+{
+  std::string error;
+  if (!applyThreadRtConfig("gimbal_ctrl", control_thread_config_, error)) {
+    RCLCPP_WARN(get_logger(), "Failed to configure control thread: %s", error.c_str());
+  }
 
-  timer_ = create_wall_timer(std::chrono::milliseconds(10), [this]() {
-    const auto current_time = now();
-    if (state_.last_update.nanoseconds() == 0) {
-      state_.last_update = current_time;
-      return;
+  using Clock = std::chrono::steady_clock;
+  const auto period = std::chrono::duration_cast<Clock::duration>(
+    std::chrono::duration<double>(1.0 / loop_rate_));
+  const double period_seconds = std::chrono::duration<double>(period).count();
+
+  // 按绝对时刻调度，唤醒延迟不会累积；积分使用理想周期而非实际间隔，调度抖动不会变成位置误差
+  auto next_tick = Clock::now() + period;
+  auto stats_start = next_tick;
+  while (rclcpp::ok() && !stop_requested_) {
+    std::this_thread::sleep_until(next_tick);
+    const auto lateness = Clock::now() - next_tick;
+
+    // 延迟超过一个周期时跳过错过的周期，并一次积分对应的理想时长
+    const uint64_t ticks = 1 + static_cast<uint64_t>(std::max(lateness / period, Clock::rep(0)));
+    updateState(ticks * period_seconds);
+
+    const double lateness_us = std::chrono::duration<double, std::micro>(lateness).count();
+    loop_stats_.count++;
+    loop_stats_.overruns += ticks - 1;
+    loop_stats_.jitter_sum_us += lateness_us;
+    loop_stats_.jitter_sq_sum_us += lateness_us * lateness_us;
+    loop_stats_.jitter_max_us = std::max(loop_stats_.jitter_max_us, lateness_us);
+
+    next_tick += period * ticks;
+    if (next_tick - stats_start >= std::chrono::seconds(1)) {
+      publishLoopStats(std::chrono::duration<double>(next_tick - stats_start).count());
+      stats_start = next_tick;
     }
-    updateState((current_time - state_.last_update).seconds());
-    state_.last_update = current_time;
-  });
+  }
 }
 
-void GimbalManagerNode::gimbalCmdCallback(const pb_rm_interfaces::msg::GimbalCmd::SharedPtr msg)
+void GimbalManagerNode::publishLoopStats(double elapsed)
 {
-  static auto last_msg = std::make_shared<pb_rm_interfaces::msg::GimbalCmd>();
+  const double count = static_cast<double>(loop_stats_.count);
+  const double mean = loop_stats_.jitter_sum_us / count;
+  const double variance = std::max(loop_stats_.jitter_sq_sum_us / count - mean * mean, 0.0);
 
-  if (
-    msg->pitch_type == last_msg->pitch_type && msg->yaw_type == last_msg->yaw_type &&
-    msg->position == last_msg->position && msg->velocity == last_msg->velocity) {
-    return;
+  // 与关节状态一样复用预分配的消息，控制循环中不分配内存
+  auto & data = loop_stats_msg_.data;
+  data[0] = count / elapsed;
+  data[1] = mean;
+  data[2] = std::sqrt(variance);
+  data[3] = loop_stats_.jitter_max_us;
+  data[4] = static_cast<double>(loop_stats_.overruns);
+  loop_stats_pub_->publish(loop_stats_msg_);
+
+  if (loop_stats_.overruns > 0) {
+    RCLCPP_WARN(
+      get_logger(), "Control loop missed %lu ticks in the last %.1f s, max jitter %.0f us",
+      loop_stats_.overruns, elapsed, loop_stats_.jitter_max_us);
+  }
+  loop_stats_ = LoopStats();
+}
+
+void GimbalManagerNode::getScanParams()
+{
+  auto types = declare_parameter<std::vector<std::string>>(
+    "scan.patterns", std::vector<std::string>{"none"});
+  if (types.size() == 1) {
+    types.assign(num_axes_, types[0]);
+  }
+  if (types.size() != num_axes_) {
+    throw std::invalid_argument{"scan.patterns must have 1 element or one per axis."};
   }
+  const auto frequency = declareAxisParameter("scan.frequency", 0.5);
+  const auto phase = declareAxisParameter("scan.phase", 0.0);
+  const auto min = declareAxisParameter("scan.min", -0.5);
+  const auto max = declareAxisParameter("scan.max", 0.5);
+  const auto dwell = declareAxisParameter("scan.dwell", 0.0);
+  const auto steps = declareAxisParameter<int64_t>("scan.steps", 2);
 
-  *last_msg = *msg;
+  scan_patterns_.resize(num_axes_);
+  for (size_t i = 0; i < num_axes_; i++) {
+    ScanPattern::Config config;
+    if (!ScanPattern::parseType(types[i], config.type)) {
+      throw std::invalid_argument{
+        "scan.patterns must be one of: none, sine, triangle, staircase."};
+    }
+    config.frequency = frequency[i];
+    config.phase = phase[i] - std::floor(phase[i]);
+    config.min = min[i];
+    config.max = max[i];
+    config.dwell = dwell[i];
+    if (
+      config.frequency < 0.0 || config.dwell < 0.0 || config.dwell >= 1.0 || steps[i] < 2 ||
+      steps[i] > std::numeric_limits<int>::max()) {
+      throw std::invalid_argument{
+        "scan.frequency must be non-negative, scan.dwell in [0, 1) and scan.steps at least 2."};
+    }
+    config.steps = static_cast<int>(steps[i]);
+    scan_patterns_[i].configure(config);
+  }
+}
 
+void GimbalManagerNode::gimbalCmdCallback(const pb_rm_interfaces::msg::GimbalCmd::SharedPtr msg)
+{
+  bool changed = false;
   if (msg->pitch_type == pb_rm_interfaces::msg::GimbalCmd::ABSOLUTE_ANGLE) {
-    state_.pitch = msg->position.pitch;
-    state_.pitch_ctrl.mode = ControlMode::POSITION;
+    changed |= setAxisCommand(pitch_axis_, ControlMode::POSITION, msg->position.pitch, 0, 0, 0);
   } else if (msg->pitch_type == pb_rm_interfaces::msg::GimbalCmd::VELOCITY) {
-    state_.pitch_ctrl = {
-      .mode = ControlMode::VELOCITY,
-      .velocity = msg->velocity.pitch,
-      .min_range = msg->velocity.pitch_min_range,
-      .max_range = msg->velocity.pitch_max_range,
-      .is_continuous =
-        std::abs((msg->velocity.pitch_max_range - msg->velocity.pitch_min_range) - 2 * M_PI) <
-        0.01};
+    changed |= setAxisCommand(
+      pitch_axis_, ControlMode::VELOCITY, 0, msg->velocity.pitch,
+      msg->velocity.pitch_min_range, msg->velocity.pitch_max_range);
   }
 
   if (msg->yaw_type == pb_rm_interfaces::msg::GimbalCmd::ABSOLUTE_ANGLE) {
-    state_.yaw = msg->position.yaw;
-    state_.yaw_ctrl.mode = ControlMode::POSITION;
+    changed |= setAxisCommand(yaw_axis_, ControlMode::POSITION, msg->position.yaw, 0, 0, 0);
   } else if (msg->yaw_type == pb_rm_interfaces::msg::GimbalCmd::VELOCITY) {
-    state_.yaw_ctrl = {
-      .mode = ControlMode::VELOCITY,
-      .velocity = msg->velocity.yaw,
-      .min_range = msg->velocity.yaw_min_range,
-      .max_range = msg->velocity.yaw_max_range,
-      .is_continuous =
-        std::abs((msg->velocity.yaw_max_range - msg->velocity.yaw_min_range) - 2 * M_PI) < 0.01};
+    changed |= setAxisCommand(
+      yaw_axis_, ControlMode::VELOCITY, 0, msg->velocity.yaw, msg->velocity.yaw_min_range,
+      msg->velocity.yaw_max_range);
+  }
+
+  if (changed) {
+    cmd_slot_.push(pending_cmd_);
   }
 }
 
-void GimbalManagerNode::updateState(double delta_time)
+void GimbalManagerNode::gimbalAxesCmdCallback(const sensor_msgs::msg::JointState::SharedPtr msg)
+{
+  // position/velocity 按轴序号索引，有限的 velocity 表示速度命令，否则有限的 position 表示位置命令
+  bool changed = false;
+  for (size_t i = 0; i < num_axes_; i++) {
+    const double velocity =
+      i < msg->velocity.size() ? msg->velocity[i] : std::numeric_limits<double>::quiet_NaN();
+    const double position =
+      i < msg->position.size() ? msg->position[i] : std::numeric_limits<double>::quiet_NaN();
+    if (std::isfinite(velocity)) {
+      changed |= setAxisCommand(
+        i, ControlMode::VELOCITY, 0, velocity, axis_min_range_[i], axis_max_range_[i]);
+    } else if (std::isfinite(position)) {
+      changed |= setAxisCommand(i, ControlMode::POSITION, position, 0, 0, 0);
+    }
+  }
+
+  if (changed) {
+    cmd_slot_.push(pending_cmd_);
+  }
+}
+
+void GimbalManagerNode::scanCallback(
+  const example_interfaces::srv::SetBool::Request::SharedPtr request,
+  example_interfaces::srv::SetBool::Response::SharedPtr response)
 {
-  if (state_.pitch_ctrl.mode == ControlMode::VELOCITY) {
-    state_.pitch = updateAxisPosition(state_.pitch, state_.pitch_ctrl, delta_time);
+  // 只影响配置了扫描波形的轴；之后对某个轴的任意命令都会结束该轴的扫描
+  bool changed = false;
+  for (size_t i = 0; i < num_axes_; i++) {
+    if (scan_patterns_[i].enabled()) {
+      changed |=
+        setAxisCommand(i, request->data ? ControlMode::SCAN : ControlMode::HOLD, 0, 0, 0, 0);
+    }
+  }
+
+  if (changed) {
+    cmd_slot_.push(pending_cmd_);
+  }
+  response->success = std::any_of(
+    scan_patterns_.begin(), scan_patterns_.end(),
+    [](const ScanPattern & pattern) { return pattern.enabled(); });
+  response->message = response->success ? "" : "No axis has a scan pattern configured";
+}
+
+bool GimbalManagerNode::setAxisCommand(
+  size_t axis, ControlMode mode, float target, float velocity, float min_range, float max_range)
+{
+  // 重复的命令不重新应用，否则速度模式在范围边界处反向后的方向会被覆盖
+  AxisCommand & cmd = pending_cmd_.axes[axis];
+  if (
+    cmd.seq != 0 && cmd.mode == mode && cmd.target == target && cmd.velocity == velocity &&
+    cmd.min_range == min_range && cmd.max_range == max_range) {
+    return false;
   }
-  if (state_.yaw_ctrl.mode == ControlMode::VELOCITY) {
-    state_.yaw = updateAxisPosition(state_.yaw, state_.yaw_ctrl, delta_time);
+  cmd.seq++;
+  cmd.mode = mode;
+  cmd.target = target;
+  cmd.velocity = velocity;
+  cmd.min_range = min_range;
+  cmd.max_range = max_range;
+  return true;
+}
+
+void GimbalManagerNode::applyCommands()
+{
+  if (cmd_slot_.count() == applied_cmd_count_) {
+    return;
+  }
+  applied_cmd_count_ = cmd_slot_.count();
+
+  AxisCommands cmds;
+  if (!cmd_slot_.readLatest(cmds)) {
+    return;
+  }
+
+  for (size_t i = 0; i < num_axes_; i++) {
+    const AxisCommand & cmd = cmds.axes[i];
+    if (cmd.seq == axes_.applied_seq[i]) {
+      continue;
+    }
+    axes_.applied_seq[i] = cmd.seq;
+
+    axes_.velocity_mode[i] = cmd.mode == ControlMode::VELOCITY;
+    axes_.scan_mode[i] = cmd.mode == ControlMode::SCAN;
+    switch (cmd.mode) {
+      case ControlMode::POSITION:
+        axes_.target[i] = cmd.target;
+        if (!trajectory_enable_) {
+          axes_.position[i] = cmd.target;
+        }
+        break;
+      case ControlMode::VELOCITY:
+        axes_.velocity[i] = cmd.velocity;
+        axes_.min_range[i] = cmd.min_range;
+        axes_.max_range[i] = cmd.max_range;
+        axes_.continuous[i] =
+          std::abs((cmd.max_range - cmd.min_range) - 2 * M_PI) < CONTINUOUS_RANGE_TOLERANCE;
+        break;
+      case ControlMode::SCAN:
+        axes_.scan_phase[i] = scan_patterns_[i].config().phase;
+        break;
+      case ControlMode::HOLD:
+        axes_.target[i] = axes_.position[i];
+        break;
+    }
+  }
+}
+
+void GimbalManagerNode::updateState(double delta_time)
+{
+  applyCommands();
+  updateAxisPositions(delta_time);
+  updateAxisScans(delta_time);
+  if (trajectory_enable_) {
+    updateAxisTrajectories(delta_time);
   }
   publishJointState();
 }
 
-double GimbalManagerNode::updateAxisPosition(double current, AxisControl & ctrl, double delta)
+void GimbalManagerNode::updateAxisPositions(double delta)
 {
-  const double displacement = ctrl.velocity * delta;
-  double new_pos = current + displacement;
+  double * position = axes_.position.data();
+  double * velocity = axes_.velocity.data();
+  const double * min_range = axes_.min_range.data();
+  const double * max_range = axes_.max_range.data();
+  const uint8_t * velocity_mode = axes_.velocity_mode.data();
+  const uint8_t * continuous = axes_.continuous.data();
+
+  // 无分支写法，各轴之间没有依赖，编译器可以向量化
+  for (size_t i = 0; i < num_axes_; i++) {
+    const double moved = position[i] + velocity[i] * delta;
+    const double range = max_range[i] - min_range[i];
+    const double wrapped = moved - range * std::floor((moved - min_range[i]) / range);
+    const bool over = moved > max_range[i];
+    const bool under = moved < min_range[i];
+    const double bounced = over ? max_range[i] : (under ? min_range[i] : moved);
+    const bool reverse = velocity_mode[i] && !continuous[i] && (over || under);
 
-  if (ctrl.is_continuous) {
-    const double range = ctrl.max_range - ctrl.min_range;
-    new_pos = ctrl.min_range + std::fmod(new_pos - ctrl.min_range, range);
-    return (new_pos < ctrl.min_range) ? new_pos + range : new_pos;
+    position[i] = velocity_mode[i] ? (continuous[i] ? wrapped : bounced) : position[i];
+    velocity[i] = reverse ? -velocity[i] : velocity[i];
   }
+}
 
-  if (new_pos > ctrl.max_range) {
-    ctrl.velocity = -ctrl.velocity;
-    return ctrl.max_range;
+void GimbalManagerNode::updateAxisScans(double delta)
+{
+  for (size_t i = 0; i < num_axes_; i++) {
+    if (!axes_.scan_mode[i]) {
+      continue;
+    }
+    const ScanPattern & pattern = scan_patterns_[i];
+    axes_.scan_phase[i] = pattern.advance(axes_.scan_phase[i], delta);
+    const double position = pattern.evaluate(axes_.scan_phase[i]);
+    if (trajectory_enable_) {
+      // 波形值作为轨迹生成的目标，进入扫描和 staircase 换档时同样受加加速度限制
+      axes_.target[i] = position;
+    } else {
+      axes_.position[i] = position;
+    }
   }
-  if (new_pos < ctrl.min_range) {
-    ctrl.velocity = -ctrl.velocity;
-    return ctrl.min_range;
+}
+
+void GimbalManagerNode::updateAxisTrajectories(double delta)
+{
+  for (size_t i = 0; i < num_axes_; i++) {
+    if (axes_.velocity_mode[i]) {
+      axes_.trajectory[i].reset(axes_.position[i], axes_.velocity[i]);
+    } else {
+      // 每个周期都以最新目标重新计算，新目标到达时从当前位置、速度、加速度平滑过渡
+      axes_.position[i] = axes_.trajectory[i].update(axes_.target[i], delta);
+    }
   }
-  return new_pos;
 }
 
 void GimbalManagerNode::publishJointState()
 {
-  auto msg = sensor_msgs::msg::JointState();
-  msg.header.stamp = now();
-  msg.name = {"gimbal_pitch_joint", "gimbal_yaw_joint"};
-  msg.position = {state_.pitch, state_.yaw};
-  joint_pub_->publish(msg);
+  const rclcpp::Time stamp = now();
+  setpoint_slot_->push(
+    GimbalSetpoint{stamp.nanoseconds(), axes_.position[pitch_axis_], axes_.position[yaw_axis_]});
+
+  joint_msg_.header.stamp = stamp;
+  std::copy(axes_.position.begin(), axes_.position.end(), joint_msg_.position.begin());
+  joint_pub_->publish(joint_msg_);
 }
 }  // namespace standard_robot_pp_ros2
 
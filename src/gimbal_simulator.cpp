@@ -0,0 +1,130 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "standard_robot_pp_ros2/gimbal_simulator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "standard_robot_pp_ros2/crc8_crc16.hpp"
+
+#define SIMULATION_STEP 0.001  // (s)
+
+namespace standard_robot_pp_ros2
+{
+
+namespace
+{
+double clamp(double value, double min, double max) { return std::max(min, std::min(value, max)); }
+
+template <typename T>
+void fillFrame(T & frame, uint8_t id)
+{
+  frame.frame_header.sof = SOF_RECEIVE;
+  frame.frame_header.len = sizeof(T) - 6;
+  frame.frame_header.id = id;
+  crc8::append_CRC8_check_sum(reinterpret_cast<uint8_t *>(&frame), sizeof(HeaderFrame));
+  crc16::append_CRC16_check_sum(reinterpret_cast<uint8_t *>(&frame), sizeof(T));
+}
+}  // namespace
+
+void GimbalSimulator::configure(const AxisConfig & pitch, const AxisConfig & yaw)
+{
+  pitch_.config = pitch;
+  yaw_.config = yaw;
+}
+
+void GimbalSimulator::reset(uint32_t time_stamp)
+{
+  for (Axis * axis : {&pitch_, &yaw_}) {
+    axis->setpoint = 0.0;
+    axis->position = 0.0;
+    axis->velocity = 0.0;
+  }
+  start_time_stamp_ = time_stamp;
+  time_ = 0.0;
+}
+
+void GimbalSimulator::setCommand(const SendRobotCmdData & cmd)
+{
+  pitch_.setpoint = cmd.data.gimbal.pitch;
+  yaw_.setpoint = cmd.data.gimbal.yaw;
+}
+
+void GimbalSimulator::step(double dt)
+{
+  while (dt > 0.0) {
+    const double h = std::min(dt, SIMULATION_STEP);
+    pitch_.integrate(h);
+    yaw_.integrate(h);
+    time_ += h;
+    dt -= h;
+  }
+}
+
+uint32_t GimbalSimulator::timeStamp() const
+{
+  return start_time_stamp_ + static_cast<uint32_t>(time_ * 1000.0);
+}
+
+ReceiveJointState GimbalSimulator::jointState()
+{
+  ReceiveJointState frame{};
+  frame.time_stamp = timeStamp();
+  frame.data.pitch = pitch_.encoderPosition();
+  frame.data.yaw = yaw_.encoderPosition();
+  fillFrame(frame, ID_JOINT_STATE);
+  return frame;
+}
+
+ReceiveImuData GimbalSimulator::imuData()
+{
+  ReceiveImuData frame{};
+  frame.time_stamp = timeStamp();
+  frame.data.yaw = std::remainder(yaw_.position, 2 * M_PI);
+  frame.data.pitch = pitch_.position;
+  frame.data.yaw_vel = yaw_.velocity;
+  frame.data.pitch_vel = pitch_.velocity;
+  fillFrame(frame, ID_IMU);
+  return frame;
+}
+
+void GimbalSimulator::Axis::integrate(double dt)
+{
+  const double wn = config.natural_frequency;
+  const double acceleration = clamp(
+    wn * wn * (setpoint - position) - 2.0 * config.damping * wn * velocity,
+    -config.max_acceleration, config.max_acceleration);
+  const double next_velocity =
+    clamp(velocity + acceleration * dt, -config.max_velocity, config.max_velocity);
+  position += 0.5 * (velocity + next_velocity) * dt;
+  velocity = next_velocity;
+
+  // 到达机械限位时速度清零
+  if (
+    config.position_limited &&
+    (position <= config.min_position || position >= config.max_position)) {
+    position = clamp(position, config.min_position, config.max_position);
+    velocity = 0.0;
+  }
+}
+
+double GimbalSimulator::Axis::encoderPosition() const
+{
+  if (config.encoder_resolution <= 0.0) {
+    return position;
+  }
+  return std::round(position / config.encoder_resolution) * config.encoder_resolution;
+}
+
+}  // namespace standard_robot_pp_ros2
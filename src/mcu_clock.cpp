@@ -0,0 +1,85 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "standard_robot_pp_ros2/mcu_clock.hpp"
+
+#include <algorithm>
+
+namespace standard_robot_pp_ros2
+{
+
+namespace
+{
+// 下位机时间戳回退超过该值时认为下位机已重启
+constexpr uint32_t MCU_RESET_THRESHOLD_MS = 1000;
+// 平均排队延迟的一阶低通系数
+constexpr double EXCESS_FILTER_ALPHA = 0.01;
+}  // namespace
+
+void McuClock::configure(std::chrono::milliseconds window, std::chrono::nanoseconds base_latency)
+{
+  window_ns_ = std::chrono::duration_cast<std::chrono::nanoseconds>(window).count();
+  base_latency_ns_ = base_latency.count();
+  reset();
+}
+
+void McuClock::reset()
+{
+  has_last_ = false;
+  excess_ns_ = 0.0;
+  synced_.store(false, std::memory_order_release);
+  latency_ns_.store(base_latency_ns_, std::memory_order_relaxed);
+}
+
+void McuClock::update(uint32_t mcu_ms, int64_t host_ns)
+{
+  if (has_last_ && last_mcu_ms_ - mcu_ms < UINT32_MAX / 2 &&
+      last_mcu_ms_ - mcu_ms > MCU_RESET_THRESHOLD_MS) {
+    reset();
+  }
+
+  const int64_t offset_ns = host_ns - static_cast<int64_t>(mcu_ms) * 1000000;
+
+  if (!has_last_) {
+    has_last_ = true;
+    block_start_ns_ = host_ns;
+    current_min_ns_ = offset_ns;
+    previous_min_ns_ = offset_ns;
+  } else if (host_ns - block_start_ns_ >= window_ns_) {
+    // 双块滑动最小值：旧块的最小值保留一个窗口，使偏移可以跟随晶振漂移缓慢变化
+    block_start_ns_ = host_ns;
+    previous_min_ns_ = current_min_ns_;
+    current_min_ns_ = offset_ns;
+  } else {
+    current_min_ns_ = std::min(current_min_ns_, offset_ns);
+  }
+  last_mcu_ms_ = mcu_ms;
+
+  const int64_t min_offset_ns = std::min(current_min_ns_, previous_min_ns_);
+  excess_ns_ += EXCESS_FILTER_ALPHA * (static_cast<double>(offset_ns - min_offset_ns) - excess_ns_);
+
+  offset_ns_.store(min_offset_ns - base_latency_ns_, std::memory_order_relaxed);
+  latency_ns_.store(base_latency_ns_ + static_cast<int64_t>(excess_ns_), std::memory_order_relaxed);
+  synced_.store(true, std::memory_order_release);
+}
+
+int64_t McuClock::toHostNs(uint32_t mcu_ms) const
+{
+  if (!isSynced()) {
+    return 0;
+  }
+  return static_cast<int64_t>(mcu_ms) * 1000000 + offset_ns_.load(std::memory_order_relaxed);
+}
+
+}  // namespace standard_robot_pp_ros2
@@ -0,0 +1,74 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "standard_robot_pp_ros2/odometry_integrator.hpp"
+
+#include <cmath>
+
+namespace standard_robot_pp_ros2
+{
+
+void OdometryIntegrator::configure(
+  bool use_imu_yaw_rate, uint32_t imu_timeout_ms, uint32_t max_dt_ms)
+{
+  use_imu_yaw_rate_ = use_imu_yaw_rate;
+  imu_timeout_ms_ = imu_timeout_ms;
+  max_dt_ms_ = max_dt_ms;
+  reset();
+}
+
+void OdometryIntegrator::reset()
+{
+  has_imu_ = false;
+  has_motion_ = false;
+  x_ = y_ = yaw_ = 0.0;
+  vx_ = vy_ = yaw_rate_ = 0.0;
+}
+
+void OdometryIntegrator::updateImu(uint32_t mcu_ms, double yaw_rate)
+{
+  has_imu_ = true;
+  imu_ms_ = mcu_ms;
+  imu_yaw_rate_ = yaw_rate;
+}
+
+void OdometryIntegrator::updateMotion(uint32_t mcu_ms, double vx, double vy, double wz)
+{
+  // 无符号减法自动处理时间戳回绕；IMU 时间戳晚于本帧时差值接近 UINT32_MAX，同样视为超时
+  const bool imu_fresh =
+    use_imu_yaw_rate_ && has_imu_ && static_cast<uint32_t>(mcu_ms - imu_ms_) <= imu_timeout_ms_;
+  const double yaw_rate = imu_fresh ? imu_yaw_rate_ : wz;
+
+  if (has_motion_) {
+    const uint32_t dt_ms = mcu_ms - motion_ms_;
+    if (dt_ms > 0 && dt_ms <= max_dt_ms_) {
+      const double dt = dt_ms * 1e-3;
+      // 中点法：以步长中点的偏航角将机体系速度转换到 odom 系
+      const double yaw_mid = yaw_ + 0.5 * yaw_rate * dt;
+      const double cos_yaw = std::cos(yaw_mid);
+      const double sin_yaw = std::sin(yaw_mid);
+      x_ += (vx * cos_yaw - vy * sin_yaw) * dt;
+      y_ += (vx * sin_yaw + vy * cos_yaw) * dt;
+      yaw_ = std::remainder(yaw_ + yaw_rate * dt, 2.0 * M_PI);
+    }
+  }
+
+  has_motion_ = true;
+  motion_ms_ = mcu_ms;
+  vx_ = vx;
+  vy_ = vy;
+  yaw_rate_ = yaw_rate;
+}
+
+}  // namespace standard_robot_pp_ros2
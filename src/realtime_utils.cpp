@@ -0,0 +1,173 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "standard_robot_pp_ros2/realtime_utils.hpp"
+
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+
+namespace standard_robot_pp_ros2
+{
+
+namespace
+{
+void appendError(std::string & error, const std::string & message)
+{
+  if (!error.empty()) {
+    error += "; ";
+  }
+  error += message;
+}
+
+int toSchedPolicy(const std::string & policy)
+{
+  if (policy == "fifo") {
+    return SCHED_FIFO;
+  } else if (policy == "rr") {
+    return SCHED_RR;
+  }
+  return SCHED_OTHER;
+}
+}  // namespace
+
+bool isValidSchedPolicy(const std::string & policy)
+{
+  return policy == "other" || policy == "fifo" || policy == "rr";
+}
+
+bool applyThreadRtConfig(
+  const std::string & name, const ThreadRtConfig & config, std::string & error)
+{
+  error.clear();
+  const pthread_t thread = pthread_self();
+
+  // Linux 线程名最长 15 个字符
+  int ret = pthread_setname_np(thread, name.substr(0, 15).c_str());
+  if (ret != 0) {
+    appendError(error, "pthread_setname_np failed: " + std::string(std::strerror(ret)));
+  }
+
+  if (!config.cpu_affinity.empty()) {
+    const long cpu_num = sysconf(_SC_NPROCESSORS_CONF);  // NOLINT(runtime/int)
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    bool cpu_ok = true;
+    for (const auto cpu : config.cpu_affinity) {
+      if (cpu < 0 || cpu >= cpu_num || cpu >= CPU_SETSIZE) {
+        appendError(
+          error, "cpu " + std::to_string(cpu) + " out of range [0, " + std::to_string(cpu_num) +
+                   ")");
+        cpu_ok = false;
+        continue;
+      }
+      CPU_SET(static_cast<int>(cpu), &cpu_set);
+    }
+    if (cpu_ok) {
+      ret = pthread_setaffinity_np(thread, sizeof(cpu_set), &cpu_set);
+      if (ret != 0) {
+        appendError(error, "pthread_setaffinity_np failed: " + std::string(std::strerror(ret)));
+      }
+    }
+  }
+
+  const int policy = toSchedPolicy(config.sched_policy);
+  sched_param param{};
+  if (policy != SCHED_OTHER) {
+    const int min_priority = sched_get_priority_min(policy);
+    const int max_priority = sched_get_priority_max(policy);
+    if (config.sched_priority < min_priority || config.sched_priority > max_priority) {
+      appendError(
+        error, "sched_priority " + std::to_string(config.sched_priority) + " out of range [" +
+                 std::to_string(min_priority) + ", " + std::to_string(max_priority) + "] for " +
+                 config.sched_policy);
+      return false;
+    }
+    param.sched_priority = config.sched_priority;
+  }
+  ret = pthread_setschedparam(thread, policy, &param);
+  if (ret != 0) {
+    appendError(
+      error, "pthread_setschedparam(" + config.sched_policy +
+               ") failed: " + std::string(std::strerror(ret)) +
+               (ret == EPERM ? " (need CAP_SYS_NICE or rtprio limit)" : ""));
+  }
+
+  return error.empty();
+}
+
+bool lockAndPrefaultMemory(size_t heap_size, std::string & error, bool & already_locked)
+{
+  error.clear();
+
+  // 进程级设置：组合运行时多个组件可能都开启，只由第一个成功的调用生效
+  static std::mutex mutex;
+  static bool locked = false;
+  std::lock_guard<std::mutex> lock(mutex);
+  already_locked = locked;
+  if (locked) {
+    return true;
+  }
+
+  if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+    const int err = errno;
+    error = "mlockall failed: " + std::string(std::strerror(err)) +
+            (err == EPERM || err == ENOMEM ? " (need CAP_IPC_LOCK or memlock limit)" : "");
+    return false;
+  }
+
+  if (heap_size > 0) {
+    // 禁止 free 归还内存给系统，并禁止大块内存走 mmap，使预分配的堆在之后被复用
+    if (mallopt(M_TRIM_THRESHOLD, -1) == 0 || mallopt(M_MMAP_MAX, 0) == 0) {
+      error = "mallopt failed";
+      return false;
+    }
+    auto * buffer = static_cast<uint8_t *>(malloc(heap_size));
+    if (buffer == nullptr) {
+      error = "failed to allocate " + std::to_string(heap_size) + " bytes for heap prefault";
+      return false;
+    }
+    const long page_size = sysconf(_SC_PAGESIZE);  // NOLINT(runtime/int)
+    for (size_t i = 0; i < heap_size; i += page_size) {
+      buffer[i] = 0;
+    }
+    free(buffer);
+  }
+
+  locked = true;
+  return true;
+}
+
+void prefaultStack(size_t stack_size)
+{
+  const size_t kChunkSize = 64 * 1024;
+  if (stack_size == 0) {
+    return;
+  }
+  volatile uint8_t chunk[kChunkSize];
+  std::memset(const_cast<uint8_t *>(chunk), 0, kChunkSize);
+  if (stack_size > kChunkSize) {
+    prefaultStack(stack_size - kChunkSize);
+  }
+  // 递归返回后再访问本帧，避免尾调用优化复用栈帧
+  chunk[0] = chunk[kChunkSize - 1];
+}
+
+}  // namespace standard_robot_pp_ros2
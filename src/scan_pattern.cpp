@@ -0,0 +1,109 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "standard_robot_pp_ros2/scan_pattern.hpp"
+
+#include <array>
+#include <cmath>
+
+// 线性插值的最大误差约为 (2*pi/N)^2/8，N = 1024 时小于 5e-6
+#define SINE_TABLE_SIZE 1024
+
+namespace standard_robot_pp_ros2
+{
+
+namespace
+{
+const std::array<double, SINE_TABLE_SIZE + 1> & sineTable()
+{
+  static const std::array<double, SINE_TABLE_SIZE + 1> table = [] {
+    std::array<double, SINE_TABLE_SIZE + 1> values;
+    for (size_t i = 0; i <= SINE_TABLE_SIZE; i++) {
+      values[i] = std::sin(2 * M_PI * i / SINE_TABLE_SIZE);
+    }
+    return values;
+  }();
+  return table;
+}
+}  // namespace
+
+double sinCycles(double phase)
+{
+  const double position = (phase - std::floor(phase)) * SINE_TABLE_SIZE;
+  const size_t index = static_cast<size_t>(position);
+  const double fraction = position - index;
+  const auto & table = sineTable();
+  return table[index] + (table[index + 1] - table[index]) * fraction;
+}
+
+bool ScanPattern::parseType(const std::string & name, Type & type)
+{
+  if (name == "none") {
+    type = Type::NONE;
+  } else if (name == "sine") {
+    type = Type::SINE;
+  } else if (name == "triangle") {
+    type = Type::TRIANGLE;
+  } else if (name == "staircase") {
+    type = Type::STAIRCASE;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+double ScanPattern::advance(double phase, double dt) const
+{
+  phase += config_.frequency * dt;
+  return phase - std::floor(phase);
+}
+
+double ScanPattern::evaluate(double phase) const
+{
+  const double span = config_.max - config_.min;
+
+  switch (config_.type) {
+    case Type::SINE:
+      return config_.min + span * 0.5 * (1.0 + sinCycles(phase));
+
+    case Type::TRIANGLE: {
+      // 一个周期依次为：上升、在 max 停留、下降、在 min 停留
+      const double ramp = (1.0 - config_.dwell) * 0.5;
+      const double hold = config_.dwell * 0.5;
+      if (phase < ramp) {
+        return config_.min + span * phase / ramp;
+      }
+      if (phase < ramp + hold) {
+        return config_.max;
+      }
+      if (phase < 2 * ramp + hold) {
+        return config_.max - span * (phase - ramp - hold) / ramp;
+      }
+      return config_.min;
+    }
+
+    case Type::STAIRCASE: {
+      // 一个周期内档位往返一次：0, 1, ..., steps-1, ..., 1
+      const int last = config_.steps - 1;
+      const int segment = static_cast<int>(phase * 2 * last);
+      const int level = segment <= last ? segment : 2 * last - segment;
+      return config_.min + span * level / last;
+    }
+
+    case Type::NONE:
+    default:
+      return config_.min;
+  }
+}
+
+}  // namespace standard_robot_pp_ros2
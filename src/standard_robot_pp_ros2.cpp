@@ -14,117 +14,467 @@
 
 #include "standard_robot_pp_ros2/standard_robot_pp_ros2.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
 #include "standard_robot_pp_ros2/crc8_crc16.hpp"
 #include "standard_robot_pp_ros2/packet_typedef.hpp"
 #include "tf2_geometry_msgs/tf2_geometry_msgs.hpp"
 
 #define USB_NOT_OK_SLEEP_TIME 1000   // (ms)
 #define USB_PROTECT_SLEEP_TIME 1000  // (ms)
+#define RECEIVE_WAIT_TIME 10         // (ms)
+#define IMU_RAW_ACCEL_TIMEOUT 20     // (ms)
+#define SEND_PERIOD 5                // (ms)
+#define FIRE_TIME_TOLERANCE 200      // (us)
 
 namespace standard_robot_pp_ros2
 {
 
+namespace
+{
+FlowControl toFlowControl(const std::string & fc_string)
+{
+  if (fc_string == "none") {
+    return FlowControl::NONE;
+  } else if (fc_string == "hardware") {
+    return FlowControl::HARDWARE;
+  } else if (fc_string == "software") {
+    return FlowControl::SOFTWARE;
+  }
+  throw std::invalid_argument{
+    "The flow_control parameter must be one of: none, software, or hardware."};
+}
+
+Parity toParity(const std::string & pt_string)
+{
+  if (pt_string == "none") {
+    return Parity::NONE;
+  } else if (pt_string == "odd") {
+    return Parity::ODD;
+  } else if (pt_string == "even") {
+    return Parity::EVEN;
+  }
+  throw std::invalid_argument{"The parity parameter must be one of: none, odd, or even."};
+}
+
+StopBits toStopBits(const std::string & sb_string)
+{
+  if (sb_string == "1" || sb_string == "1.0") {
+    return StopBits::ONE;
+  } else if (sb_string == "1.5") {
+    return StopBits::ONE_POINT_FIVE;
+  } else if (sb_string == "2" || sb_string == "2.0") {
+    return StopBits::TWO;
+  }
+  throw std::invalid_argument{"The stop_bits parameter must be one of: 1, 1.5, or 2."};
+}
+
+// 读取 URDF 中关节的父子坐标系、原点与转轴
+bool loadGimbalJoint(
+  const urdf::Model & model, const std::string & name, std::string & parent_frame,
+  std::string & child_frame, tf2::Transform & origin, tf2::Vector3 & axis, std::string & error)
+{
+  const urdf::JointConstSharedPtr joint = model.getJoint(name);
+  if (!joint) {
+    error = "joint " + name + " not found";
+    return false;
+  }
+  if (joint->type != urdf::Joint::REVOLUTE && joint->type != urdf::Joint::CONTINUOUS) {
+    error = "joint " + name + " is not revolute or continuous";
+    return false;
+  }
+
+  const auto & pose = joint->parent_to_joint_origin_transform;
+  double qx, qy, qz, qw;
+  pose.rotation.getQuaternion(qx, qy, qz, qw);
+  parent_frame = joint->parent_link_name;
+  child_frame = joint->child_link_name;
+  origin = tf2::Transform(
+    tf2::Quaternion(qx, qy, qz, qw),
+    tf2::Vector3(pose.position.x, pose.position.y, pose.position.z));
+  axis = tf2::Vector3(joint->axis.x, joint->axis.y, joint->axis.z);
+  return true;
+}
+
+// 统计数据中通过 CRC8 校验的帧头数量
+int countValidHeaderFrames(const std::vector<uint8_t> & data)
+{
+  int count = 0;
+  size_t pos = 0;
+  while (pos + sizeof(HeaderFrame) <= data.size()) {
+    if (data[pos] != SOF_RECEIVE) {
+      pos++;
+      continue;
+    }
+    HeaderFrame header_frame = fromBytes<HeaderFrame>(data.data() + pos, sizeof(HeaderFrame));
+    if (crc8::verify_CRC8_check_sum(
+          reinterpret_cast<uint8_t *>(&header_frame), sizeof(header_frame))) {
+      count++;
+      pos += sizeof(HeaderFrame);
+    } else {
+      pos++;
+    }
+  }
+  return count;
+}
+}  // namespace
+
 StandardRobotPpRos2Node::StandardRobotPpRos2Node(const rclcpp::NodeOptions & options)
-: Node("StandardRobotPpRos2Node", options),
+: LifecycleNode("StandardRobotPpRos2Node", options),
+  is_usb_ok_(false),
+  is_active_(false),
   owned_ctx_{new IoContext(2)},
-  serial_driver_{new drivers::serial_driver::SerialDriver(*owned_ctx_)}
+  serial_driver_{new drivers::serial_driver::SerialDriver(*owned_ctx_)},
+  reconfigure_requested_(false),
+  stop_requested_(false),
+  last_receive_host_ns_(0),
+  link_generation_(0),
+  debug_batch_names_changed_(true),
+  aim_solution_valid_(false),
+  gimbal_feedback_(0),
+  cmd_input_{},
+  send_robot_cmd_data_{}
 {
   RCLCPP_INFO(get_logger(), "Start StandardRobotPpRos2Node!");
 
   getParams();
-  createPublisher();
-  createSubscription();
 
-  robot_models_.chassis = {
-    {0, "无底盘"}, {1, "麦轮底盘"}, {2, "全向轮底盘"}, {3, "舵轮底盘"}, {4, "平衡底盘"}};
-  robot_models_.gimbal = {{0, "无云台"}, {1, "yaw_pitch直连云台"}};
-  robot_models_.shoot = {{0, "无发射机构"}, {1, "摩擦轮+拨弹盘"}, {2, "气动+拨弹盘"}};
-  robot_models_.arm = {{0, "无机械臂"}, {1, "mini机械臂"}};
-  robot_models_.custom_controller = {{0, "无自定义控制器"}, {1, "mini自定义控制器"}};
+  if (lock_memory_) {
+    lockMemory();
+  }
 
-  serial_port_protect_thread_ = std::thread(&StandardRobotPpRos2Node::serialPortProtect, this);
-  receive_thread_ = std::thread(&StandardRobotPpRos2Node::receiveData, this);
-  send_thread_ = std::thread(&StandardRobotPpRos2Node::sendData, this);
+  // 不受生命周期管理器控制时，直接进入 active 状态
+  if (autostart_) {
+    if (configure().id() == lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE) {
+      activate();
+    }
+  }
 }
 
 StandardRobotPpRos2Node::~StandardRobotPpRos2Node()
 {
-  if (send_thread_.joinable()) {
-    send_thread_.join();
+  // 分离的线程仍在访问本节点，不能继续析构，直接终止进程以保证退出时间有界
+  if (!stopThreads() && !threadsFinished()) {
+    RCLCPP_FATAL(get_logger(), "Detached I/O threads still running, aborting");
+    std::abort();
   }
 
-  if (receive_thread_.joinable()) {
-    receive_thread_.join();
+  if (owned_ctx_) {
+    owned_ctx_->waitForExit();
   }
+}
 
-  if (serial_port_protect_thread_.joinable()) {
-    serial_port_protect_thread_.join();
+/********************************************************/
+/* Lifecycle                                            */
+/********************************************************/
+StandardRobotPpRos2Node::CallbackReturn StandardRobotPpRos2Node::on_configure(
+  const rclcpp_lifecycle::State & /*state*/)
+{
+  RCLCPP_INFO(get_logger(), "Configuring");
+
+  // 上次超时分离的线程仍在运行时不能重新启动
+  if (!threadsFinished()) {
+    RCLCPP_ERROR(get_logger(), "Detached I/O threads still running, cannot configure");
+    return CallbackReturn::FAILURE;
   }
 
-  if (serial_driver_->port()->is_open()) {
-    serial_driver_->port()->close();
+  createPublisher();
+  createSubscription();
+  createService();
+
+  // 姿态历史在 configure 时按参数分配，并注册到进程内供组合运行的节点直接查询
+  attitude_history_ = std::make_shared<AttitudeHistory>(attitude_history_size_);
+  ProcessRegistry<AttitudeHistory>::add(get_fully_qualified_name(), attitude_history_);
+
+  takePendingLinkConfig();
+  reconfigure_requested_ = false;
+  stop_requested_ = false;
+
+  if (baud_rate_auto_detect_ && !simulation_enable_) {
+    detectBaudRate();
   }
 
-  if (owned_ctx_) {
-    owned_ctx_->waitForExit();
+  try {
+    std::lock_guard<std::mutex> lock(port_mutex_);
+    serial_driver_->init_port(device_name_, *device_config_);
+  } catch (const std::exception & ex) {
+    RCLCPP_ERROR(get_logger(), "Init serial port failed : %s", ex.what());
+    resetInterfaces();
+    return CallbackReturn::FAILURE;
+  }
+
+  // 打开失败时由保护线程继续重试
+  try {
+    if (openPort()) {
+      RCLCPP_INFO(get_logger(), "Serial port opened!");
+      is_usb_ok_ = true;
+    }
+  } catch (const std::exception & ex) {
+    RCLCPP_ERROR(get_logger(), "Open serial port failed : %s", ex.what());
+  }
+
+  startThreads();
+
+  return CallbackReturn::SUCCESS;
+}
+
+StandardRobotPpRos2Node::CallbackReturn StandardRobotPpRos2Node::on_activate(
+  const rclcpp_lifecycle::State & /*state*/)
+{
+  setPublishersActivated(true);
+  is_active_ = true;
+  RCLCPP_INFO(get_logger(), "Activated");
+  return CallbackReturn::SUCCESS;
+}
+
+StandardRobotPpRos2Node::CallbackReturn StandardRobotPpRos2Node::on_deactivate(
+  const rclcpp_lifecycle::State & /*state*/)
+{
+  is_active_ = false;
+  setPublishersActivated(false);
+  RCLCPP_INFO(get_logger(), "Deactivated");
+  return CallbackReturn::SUCCESS;
+}
+
+StandardRobotPpRos2Node::CallbackReturn StandardRobotPpRos2Node::on_cleanup(
+  const rclcpp_lifecycle::State & /*state*/)
+{
+  is_usb_ok_ = false;
+  // 分离的线程仍在使用发布者与姿态历史，此时保留所有接口，等线程退出后再次清理
+  if (!stopThreads()) {
+    RCLCPP_ERROR(get_logger(), "I/O threads still running, interfaces kept alive");
+    return CallbackReturn::FAILURE;
+  }
+  resetInterfaces();
+  RCLCPP_INFO(get_logger(), "Cleaned up");
+  return CallbackReturn::SUCCESS;
+}
+
+StandardRobotPpRos2Node::CallbackReturn StandardRobotPpRos2Node::on_shutdown(
+  const rclcpp_lifecycle::State & /*state*/)
+{
+  is_active_ = false;
+  is_usb_ok_ = false;
+  if (!stopThreads()) {
+    RCLCPP_ERROR(get_logger(), "I/O threads still running, interfaces kept alive");
+    return CallbackReturn::FAILURE;
+  }
+  resetInterfaces();
+  RCLCPP_INFO(get_logger(), "Shut down");
+  return CallbackReturn::SUCCESS;
+}
+
+void StandardRobotPpRos2Node::setPublishersActivated(bool activated)
+{
+  std::lock_guard<std::mutex> lock(managed_publishers_mutex_);
+  for (auto & publisher : managed_publishers_) {
+    if (activated) {
+      publisher->on_activate();
+    } else {
+      publisher->on_deactivate();
+    }
+  }
+}
+
+void StandardRobotPpRos2Node::resetInterfaces()
+{
+  {
+    std::lock_guard<std::mutex> lock(managed_publishers_mutex_);
+    managed_publishers_.clear();
   }
+  debug_pub_map_.clear();
+  debug_channels_.fill(DebugChannel());
+
+  imu_pub_.reset();
+  imu_raw_pub_.reset();
+  robot_state_info_pub_.reset();
+  joint_state_pub_.reset();
+  robot_motion_pub_.reset();
+  event_data_pub_.reset();
+  all_robot_hp_pub_.reset();
+  game_status_pub_.reset();
+  ground_robot_position_pub_.reset();
+  rfid_status_pub_.reset();
+  robot_status_pub_.reset();
+  buff_pub_.reset();
+  debug_batch_pub_.reset();
+  pid_debug_pub_.reset();
+
+  cmd_vel_sub_.reset();
+  cmd_gimbal_joint_sub_.reset();
+  cmd_shoot_sub_.reset();
+  cmd_tracking_sub_.reset();
+  tf_listener_.reset();
+  tf_buffer_.reset();
+  cmd_shoot_at_sub_.reset();
+  cmd_shoot_when_aimed_sub_.reset();
+
+  pid_debug_dump_srv_.reset();
+  attitude_srv_.reset();
+
+  robot_description_sub_.reset();
+  odometry_pub_.reset();
+  tf_broadcaster_.reset();
+  std::atomic_store(&gimbal_joints_, std::shared_ptr<const GimbalJoints>());
+
+  ProcessRegistry<AttitudeHistory>::remove(get_fully_qualified_name());
+  attitude_history_.reset();
 }
 
 void StandardRobotPpRos2Node::createPublisher()
 {
-  imu_pub_ = this->create_publisher<sensor_msgs::msg::Imu>("serial/imu", 10);
-  robot_state_info_pub_ =
-    this->create_publisher<pb_rm_interfaces::msg::RobotStateInfo>("serial/robot_state_info", 10);
-  joint_state_pub_ =
-    this->create_publisher<sensor_msgs::msg::JointState>("serial/gimbal_joint_state", 10);
-  robot_motion_pub_ = this->create_publisher<geometry_msgs::msg::Twist>("serial/robot_motion", 10);
-  event_data_pub_ =
-    this->create_publisher<pb_rm_interfaces::msg::EventData>("referee/event_data", 10);
-  all_robot_hp_pub_ =
-    this->create_publisher<pb_rm_interfaces::msg::GameRobotHP>("referee/all_robot_hp", 10);
-  game_status_pub_ =
-    this->create_publisher<pb_rm_interfaces::msg::GameStatus>("referee/game_status", 10);
-  ground_robot_position_pub_ = this->create_publisher<pb_rm_interfaces::msg::GroundRobotPosition>(
-    "referee/ground_robot_position", 10);
-  rfid_status_pub_ =
-    this->create_publisher<pb_rm_interfaces::msg::RfidStatus>("referee/rfid_status", 10);
-  robot_status_pub_ =
-    this->create_publisher<pb_rm_interfaces::msg::RobotStatus>("referee/robot_status", 10);
-  buff_pub_ = this->create_publisher<pb_rm_interfaces::msg::Buff>("referee/buff", 10);
+  imu_pub_ = createManagedPublisher<sensor_msgs::msg::Imu>("serial/imu", topicQos("imu"));
+  imu_raw_pub_ =
+    createManagedPublisher<sensor_msgs::msg::Imu>("serial/imu_raw", topicQos("imu_raw"));
+  robot_state_info_pub_ = createManagedPublisher<pb_rm_interfaces::msg::RobotStateInfo>(
+    "serial/robot_state_info", topicQos("robot_state_info"));
+  joint_state_pub_ = createManagedPublisher<sensor_msgs::msg::JointState>(
+    "serial/gimbal_joint_state", topicQos("gimbal_joint_state"));
+  robot_motion_pub_ = createManagedPublisher<geometry_msgs::msg::Twist>(
+    "serial/robot_motion", topicQos("robot_motion"));
+  event_data_pub_ = createManagedPublisher<pb_rm_interfaces::msg::EventData>(
+    "referee/event_data", topicQos("event_data"));
+  all_robot_hp_pub_ = createManagedPublisher<pb_rm_interfaces::msg::GameRobotHP>(
+    "referee/all_robot_hp", topicQos("all_robot_hp"));
+  game_status_pub_ = createManagedPublisher<pb_rm_interfaces::msg::GameStatus>(
+    "referee/game_status", topicQos("game_status"));
+  ground_robot_position_pub_ = createManagedPublisher<pb_rm_interfaces::msg::GroundRobotPosition>(
+    "referee/ground_robot_position", topicQos("ground_robot_position"));
+  rfid_status_pub_ = createManagedPublisher<pb_rm_interfaces::msg::RfidStatus>(
+    "referee/rfid_status", topicQos("rfid_status"));
+  robot_status_pub_ = createManagedPublisher<pb_rm_interfaces::msg::RobotStatus>(
+    "referee/robot_status", topicQos("robot_status"));
+  buff_pub_ = createManagedPublisher<pb_rm_interfaces::msg::Buff>("referee/buff", topicQos("buff"));
+
+  imu_decimator_.configure(topic_qos_.at("imu").decimation);
+  imu_raw_decimator_.configure(topic_qos_.at("imu_raw").decimation);
+  has_imu_raw_ = false;
+  robot_state_info_decimator_.configure(topic_qos_.at("robot_state_info").decimation);
+  joint_state_decimator_.configure(topic_qos_.at("gimbal_joint_state").decimation);
+  robot_motion_decimator_.configure(topic_qos_.at("robot_motion").decimation);
+  event_data_decimator_.configure(topic_qos_.at("event_data").decimation);
+  all_robot_hp_decimator_.configure(topic_qos_.at("all_robot_hp").decimation);
+  game_status_decimator_.configure(topic_qos_.at("game_status").decimation);
+  ground_robot_position_decimator_.configure(topic_qos_.at("ground_robot_position").decimation);
+  rfid_status_decimator_.configure(topic_qos_.at("rfid_status").decimation);
+  robot_status_decimator_.configure(topic_qos_.at("robot_status").decimation);
+  buff_decimator_.configure(topic_qos_.at("buff").decimation);
+
+  // 新建的发布者没有历史数据，首帧必须发布
+  for (auto * detector :
+       {&robot_state_info_change_, &event_data_change_, &all_robot_hp_change_,
+        &game_status_change_, &rfid_status_change_, &buff_change_}) {
+    detector->reset();
+  }
+
+  if (gimbal_tf_enable_ || (odometry_enable_ && odometry_publish_tf_)) {
+    tf_broadcaster_ = std::make_unique<tf2_ros::TransformBroadcaster>(*this);
+  }
+  gimbal_tf_msgs_.resize(2);
+
+  if (odometry_enable_) {
+    odometry_pub_ =
+      createManagedPublisher<nav_msgs::msg::Odometry>("serial/odometry", topicQos("odometry"));
+    odometry_decimator_.configure(topic_qos_.at("odometry").decimation);
+    odometry_integrator_.reset();
+  }
+
+  if (debug_batched_) {
+    debug_batch_pub_ = createManagedPublisher<example_interfaces::msg::Float64MultiArray>(
+      "serial/debug", topicQos("debug"));
+    debug_batch_msg_.layout.dim.resize(2);
+    debug_batch_msg_.layout.dim[0].label.clear();
+    debug_batch_msg_.layout.dim[1].label = "time_stamp_ms,value,type";
+    debug_batch_msg_.layout.dim[1].size = 3;
+    debug_batch_msg_.layout.dim[1].stride = 3;
+    debug_batch_msg_.data.reserve(DEBUG_PACKAGE_NUM * 3);
+    debug_batch_names_changed_ = true;
+  }
+
+  pid_debug_pub_ = createManagedPublisher<example_interfaces::msg::Float64MultiArray>(
+    "serial/pid_debug", topicQos("pid_debug"));
+  pid_debug_msg_.layout.dim.resize(2);
+  pid_debug_msg_.layout.dim[0].label = "samples";
+  pid_debug_msg_.layout.dim[1].label = "time_stamp_ms,fdb,ref,pid_out";
+  pid_debug_msg_.layout.dim[1].size = 4;
+  pid_debug_msg_.layout.dim[1].stride = 4;
+  pid_debug_msg_.data.clear();
+  pid_debug_msg_.data.reserve(pid_debug_batch_size_ * 4);
+  pid_debug_sample_count_ = 0;
+  {
+    std::lock_guard<std::mutex> lock(pid_debug_history_mutex_);
+    pid_debug_history_.reset(pid_debug_history_size_);
+  }
+}
+
+rclcpp::QoS StandardRobotPpRos2Node::topicQos(const std::string & key) const
+{
+  return toQos(topic_qos_.at(key));
+}
+
+void StandardRobotPpRos2Node::createService()
+{
+  pid_debug_dump_srv_ = this->create_service<example_interfaces::srv::Trigger>(
+    "serial/pid_debug/dump", std::bind(
+                               &StandardRobotPpRos2Node::dumpPidDebugHistory, this,
+                               std::placeholders::_1, std::placeholders::_2));
+  attitude_srv_ = this->create_service<srv::GetAttitude>(
+    "serial/attitude_history/query", std::bind(
+                                       &StandardRobotPpRos2Node::getAttitude, this,
+                                       std::placeholders::_1, std::placeholders::_2));
 }
 
 void StandardRobotPpRos2Node::createNewDebugPublisher(const std::string & name)
 {
   RCLCPP_INFO(get_logger(), "Create new debug publisher: %s", name.c_str());
   std::string topic_name = "serial/debug/" + name;
-  auto debug_pub = this->create_publisher<example_interfaces::msg::Float64>(topic_name, 10);
+  auto debug_pub =
+    createManagedPublisher<example_interfaces::msg::Float64>(topic_name, topicQos("debug"));
   debug_pub_map_.insert(std::make_pair(name, debug_pub));
 }
 
 void StandardRobotPpRos2Node::createSubscription()
 {
   cmd_vel_sub_ = this->create_subscription<geometry_msgs::msg::Twist>(
-    "cmd_vel", 10,
+    "cmd_vel", topicQos("cmd_vel"),
     std::bind(&StandardRobotPpRos2Node::cmdVelCallback, this, std::placeholders::_1));
 
   cmd_gimbal_joint_sub_ = this->create_subscription<sensor_msgs::msg::JointState>(
-    "cmd_gimbal_joint", 10,
+    "cmd_gimbal_joint", topicQos("cmd_gimbal_joint"),
     std::bind(&StandardRobotPpRos2Node::cmdGimbalJointCallback, this, std::placeholders::_1));
 
   cmd_shoot_sub_ = this->create_subscription<example_interfaces::msg::UInt8>(
-    "cmd_shoot", 10,
+    "cmd_shoot", topicQos("cmd_shoot"),
     std::bind(&StandardRobotPpRos2Node::cmdShootCallback, this, std::placeholders::_1));
+  // 目标不在解算坐标系中时通过 TF 转换
+  if (aim_enable_) {
+    tf_buffer_ = std::make_unique<tf2_ros::Buffer>(get_clock());
+    tf_listener_ = std::make_unique<tf2_ros::TransformListener>(*tf_buffer_, *this);
+  }
   cmd_tracking_sub_ = this->create_subscription<auto_aim_interfaces::msg::Target>(
-    "tracker/target",10,std::bind(&StandardRobotPpRos2Node::cmdTrakcingCallback,this,std::placeholders::_1));
-
+    "tracker/target", topicQos("tracker_target"),
+    std::bind(&StandardRobotPpRos2Node::cmdTrakcingCallback, this, std::placeholders::_1));
+  cmd_shoot_at_sub_ = this->create_subscription<builtin_interfaces::msg::Time>(
+    "cmd_shoot_at", topicQos("cmd_shoot"),
+    std::bind(&StandardRobotPpRos2Node::cmdShootAtCallback, this, std::placeholders::_1));
+  cmd_shoot_when_aimed_sub_ = this->create_subscription<example_interfaces::msg::Float64>(
+    "cmd_shoot_when_aimed", topicQos("cmd_shoot"),
+    std::bind(&StandardRobotPpRos2Node::cmdShootWhenAimedCallback, this, std::placeholders::_1));
+
+  if (gimbal_tf_enable_) {
+    // robot_state_publisher 以 transient_local 发布 URDF
+    robot_description_sub_ = this->create_subscription<std_msgs::msg::String>(
+      "robot_description", rclcpp::QoS(1).reliable().transient_local(),
+      std::bind(
+        &StandardRobotPpRos2Node::robotDescriptionCallback, this, std::placeholders::_1));
+  }
 }
 
 void StandardRobotPpRos2Node::getParams()
 {
-  using FlowControl = drivers::serial_driver::FlowControl;
-  using Parity = drivers::serial_driver::Parity;
-  using StopBits = drivers::serial_driver::StopBits;
-
   uint32_t baud_rate{};
   auto fc = FlowControl::NONE;
   auto pt = Parity::NONE;
@@ -145,99 +495,671 @@ void StandardRobotPpRos2Node::getParams()
   }
 
   try {
-    const auto fc_string = declare_parameter<std::string>("flow_control", "");
-
-    if (fc_string == "none") {
-      fc = FlowControl::NONE;
-    } else if (fc_string == "hardware") {
-      fc = FlowControl::HARDWARE;
-    } else if (fc_string == "software") {
-      fc = FlowControl::SOFTWARE;
-    } else {
-      throw std::invalid_argument{
-        "The flow_control parameter must be one of: none, software, or hardware."};
-    }
+    fc = toFlowControl(declare_parameter<std::string>("flow_control", ""));
   } catch (rclcpp::ParameterTypeException & ex) {
     RCLCPP_ERROR(get_logger(), "The flow_control provided was invalid");
     throw ex;
   }
 
   try {
-    const auto pt_string = declare_parameter<std::string>("parity", "");
-
-    if (pt_string == "none") {
-      pt = Parity::NONE;
-    } else if (pt_string == "odd") {
-      pt = Parity::ODD;
-    } else if (pt_string == "even") {
-      pt = Parity::EVEN;
-    } else {
-      throw std::invalid_argument{"The parity parameter must be one of: none, odd, or even."};
-    }
+    pt = toParity(declare_parameter<std::string>("parity", ""));
   } catch (rclcpp::ParameterTypeException & ex) {
     RCLCPP_ERROR(get_logger(), "The parity provided was invalid");
     throw ex;
   }
 
   try {
-    const auto sb_string = declare_parameter<std::string>("stop_bits", "");
-
-    if (sb_string == "1" || sb_string == "1.0") {
-      sb = StopBits::ONE;
-    } else if (sb_string == "1.5") {
-      sb = StopBits::ONE_POINT_FIVE;
-    } else if (sb_string == "2" || sb_string == "2.0") {
-      sb = StopBits::TWO;
-    } else {
-      throw std::invalid_argument{"The stop_bits parameter must be one of: 1, 1.5, or 2."};
-    }
+    sb = toStopBits(declare_parameter<std::string>("stop_bits", ""));
   } catch (rclcpp::ParameterTypeException & ex) {
     RCLCPP_ERROR(get_logger(), "The stop_bits provided was invalid");
     throw ex;
   }
 
-  device_config_ =
-    std::make_unique<drivers::serial_driver::SerialPortConfig>(baud_rate, fc, pt, sb);
+  device_config_ = std::make_unique<SerialPortConfig>(baud_rate, fc, pt, sb);
 
   debug_ = declare_parameter("debug", false);
+  debug_batched_ = declare_parameter("debug_batched", false);
+  autostart_ = declare_parameter("autostart", true);
+
+  const int heartbeat_ms = declare_parameter<int>("on_change.heartbeat_ms", 1000);
+  if (heartbeat_ms < 0) {
+    throw std::invalid_argument{"on_change.heartbeat_ms must be non-negative."};
+  }
+  const std::chrono::milliseconds heartbeat(heartbeat_ms);
+  robot_state_info_change_.configure(
+    declare_parameter("on_change.robot_state_info", false), heartbeat);
+  event_data_change_.configure(declare_parameter("on_change.event_data", false), heartbeat);
+  all_robot_hp_change_.configure(declare_parameter("on_change.all_robot_hp", false), heartbeat);
+  game_status_change_.configure(declare_parameter("on_change.game_status", false), heartbeat);
+  rfid_status_change_.configure(declare_parameter("on_change.rfid_status", false), heartbeat);
+  buff_change_.configure(declare_parameter("on_change.buff", false), heartbeat);
+
+  // 话题 QoS：默认与原先一致 (reliable, volatile, depth 10)，仅在变化时发布的话题默认 transient_local
+  const TopicQos on_change_defaults{"reliable", "transient_local", 1, 1};
+  auto referee_defaults = [&on_change_defaults](const ChangeDetector & detector) {
+    return detector.enabled() ? on_change_defaults : TopicQos();
+  };
+  declareTopicQos("imu", TopicQos(), true);
+  declareTopicQos("imu_raw", TopicQos(), true);
+  declareTopicQos("robot_state_info", referee_defaults(robot_state_info_change_), true);
+  declareTopicQos("gimbal_joint_state", TopicQos(), true);
+  declareTopicQos("robot_motion", TopicQos(), true);
+  declareTopicQos("odometry", TopicQos(), true);
+  declareTopicQos("event_data", referee_defaults(event_data_change_), true);
+  declareTopicQos("all_robot_hp", referee_defaults(all_robot_hp_change_), true);
+  declareTopicQos("game_status", referee_defaults(game_status_change_), true);
+  declareTopicQos("ground_robot_position", TopicQos(), true);
+  declareTopicQos("rfid_status", referee_defaults(rfid_status_change_), true);
+  declareTopicQos("robot_status", TopicQos(), true);
+  declareTopicQos("buff", referee_defaults(buff_change_), true);
+  declareTopicQos("debug", TopicQos(), false);
+  declareTopicQos("pid_debug", TopicQos(), false);
+  declareTopicQos("cmd_vel", TopicQos(), false);
+  declareTopicQos("cmd_gimbal_joint", TopicQos(), false);
+  declareTopicQos("cmd_shoot", TopicQos(), false);
+  declareTopicQos("tracker_target", TopicQos(), false);
+
+  const int time_sync_window_ms = declare_parameter<int>("time_sync.window_ms", 5000);
+  const double base_latency_ms = declare_parameter("time_sync.base_latency_ms", 0.5);
+  if (time_sync_window_ms <= 0 || base_latency_ms < 0.0) {
+    throw std::invalid_argument{
+      "time_sync.window_ms must be positive and time_sync.base_latency_ms non-negative."};
+  }
+  mcu_clock_.configure(
+    std::chrono::milliseconds(time_sync_window_ms),
+    std::chrono::nanoseconds(static_cast<int64_t>(base_latency_ms * 1e6)));
+
+  // IMU 协方差对角线 (x, y, z)，原始数据包不含姿态，其 orientation_covariance 首元素固定为 -1
+  const std::string imu_frame_id = declare_parameter<std::string>("imu.frame_id", "odom");
+  const auto orientation_covariance = declare_parameter(
+    "imu.orientation_covariance", std::vector<double>{1e-4, 1e-4, 1e-4});
+  const auto angular_velocity_covariance = declare_parameter(
+    "imu.angular_velocity_covariance", std::vector<double>{1e-5, 1e-5, 1e-5});
+  const auto linear_acceleration_covariance = declare_parameter(
+    "imu.linear_acceleration_covariance", std::vector<double>{1e-3, 1e-3, 1e-3});
+  if (
+    orientation_covariance.size() != 3 || angular_velocity_covariance.size() != 3 ||
+    linear_acceleration_covariance.size() != 3) {
+    throw std::invalid_argument{"imu.*_covariance must have 3 elements."};
+  }
+  for (auto * msg : {&imu_msg_, &imu_raw_msg_}) {
+    msg->header.frame_id = imu_frame_id;
+    for (size_t i = 0; i < 3; i++) {
+      msg->orientation_covariance[i * 4] = orientation_covariance[i];
+      msg->angular_velocity_covariance[i * 4] = angular_velocity_covariance[i];
+      msg->linear_acceleration_covariance[i * 4] = linear_acceleration_covariance[i];
+    }
+  }
+  imu_raw_msg_.orientation_covariance[0] = -1.0;
+
+  // 关节名与数组长度固定，发布时只更新时间戳与关节角
+  joint_state_msg_.name = {"gimbal_pitch_joint", "gimbal_yaw_joint"};
+  joint_state_msg_.position.resize(2);
+
+  gimbal_tf_enable_ = declare_parameter("gimbal_tf.enable", false);
+  gimbal_pitch_joint_ =
+    declare_parameter<std::string>("gimbal_tf.pitch_joint", "gimbal_pitch_joint");
+  gimbal_yaw_joint_ = declare_parameter<std::string>("gimbal_tf.yaw_joint", "gimbal_yaw_joint");
+
+  odometry_enable_ = declare_parameter("odometry.enable", false);
+  odometry_publish_tf_ = declare_parameter("odometry.publish_tf", true);
+  odometry_msg_.header.frame_id = declare_parameter<std::string>("odometry.frame_id", "odom");
+  odometry_msg_.child_frame_id =
+    declare_parameter<std::string>("odometry.child_frame_id", "base_footprint");
+  const bool use_imu_yaw_rate = declare_parameter("odometry.use_imu_yaw_rate", true);
+  const int imu_timeout_ms = declare_parameter<int>("odometry.imu_timeout_ms", 20);
+  const int max_dt_ms = declare_parameter<int>("odometry.max_dt_ms", 100);
+  // 协方差对角线：pose 为 x, y, yaw；twist 为 vx, vy, wz
+  const auto pose_covariance = declare_parameter(
+    "odometry.pose_covariance", std::vector<double>{1e-3, 1e-3, 1e-3});
+  const auto twist_covariance = declare_parameter(
+    "odometry.twist_covariance", std::vector<double>{1e-3, 1e-3, 1e-3});
+  if (
+    imu_timeout_ms < 0 || max_dt_ms <= 0 || pose_covariance.size() != 3 ||
+    twist_covariance.size() != 3) {
+    throw std::invalid_argument{
+      "odometry.imu_timeout_ms must be non-negative, odometry.max_dt_ms positive, and "
+      "odometry.pose_covariance/twist_covariance must have 3 elements."};
+  }
+  odometry_integrator_.configure(use_imu_yaw_rate, imu_timeout_ms, max_dt_ms);
+  // 平面运动中 z, roll, pitch 不可观测，给出较大方差
+  const size_t diagonal[3] = {0, 7, 35};  // x, y, yaw
+  const size_t unobserved[3] = {14, 21, 28};  // z, roll, pitch
+  for (size_t i = 0; i < 3; i++) {
+    odometry_msg_.pose.covariance[diagonal[i]] = pose_covariance[i];
+    odometry_msg_.twist.covariance[diagonal[i]] = twist_covariance[i];
+    odometry_msg_.pose.covariance[unobserved[i]] = 1e6;
+    odometry_msg_.twist.covariance[unobserved[i]] = 1e6;
+  }
+  odometry_tf_msg_.header.frame_id = odometry_msg_.header.frame_id;
+  odometry_tf_msg_.child_frame_id = odometry_msg_.child_frame_id;
+
+  simulation_enable_ = declare_parameter("simulation.enable", false);
+  simulator_.configure(
+    getSimulationAxisParams("simulation.pitch"), getSimulationAxisParams("simulation.yaw"));
+
+  gimbal_fast_path_enable_ = declare_parameter("gimbal_fast_path.enable", true);
+  const std::string gimbal_setpoint_source =
+    declare_parameter<std::string>("gimbal_fast_path.source", "gimbal_manager");
+  const int gimbal_setpoint_timeout_ms = declare_parameter<int>("gimbal_fast_path.timeout_ms", 100);
+  if (gimbal_setpoint_source.empty() || gimbal_setpoint_timeout_ms <= 0) {
+    throw std::invalid_argument{
+      "gimbal_fast_path.source must not be empty and gimbal_fast_path.timeout_ms must be "
+      "positive."};
+  }
+  // 相对名称按本节点的命名空间解析为节点全名
+  const std::string ns = get_namespace();
+  gimbal_setpoint_key_ = gimbal_setpoint_source.front() == '/'
+                           ? gimbal_setpoint_source
+                           : (ns == "/" ? "" : ns) + "/" + gimbal_setpoint_source;
+  gimbal_setpoint_timeout_ = std::chrono::milliseconds(gimbal_setpoint_timeout_ms);
+
+  aim_enable_ = declare_parameter("aim.enable", false);
+  const double bullet_speed = declare_parameter("aim.bullet_speed", 25.0);
+  const int aim_target_timeout_ms = declare_parameter<int>("aim.target_timeout_ms", 200);
+  const double aim_extra_delay_ms = declare_parameter("aim.extra_delay_ms", 0.0);
+  aim_frame_id_ = declare_parameter<std::string>("aim.frame_id", "odom");
+  if (bullet_speed <= 0.0 || aim_target_timeout_ms <= 0 || aim_extra_delay_ms < 0.0) {
+    throw std::invalid_argument{
+      "aim.bullet_speed and aim.target_timeout_ms must be positive, "
+      "aim.extra_delay_ms non-negative."};
+  }
+  target_predictor_.configure(bullet_speed);
+  aim_target_timeout_ = std::chrono::milliseconds(aim_target_timeout_ms);
+  aim_extra_delay_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::duration<double, std::milli>(aim_extra_delay_ms));
+
+  const int fire_aim_timeout_ms = declare_parameter<int>("fire_scheduler.aim_timeout_ms", 500);
+  if (fire_aim_timeout_ms <= 0) {
+    throw std::invalid_argument{"fire_scheduler.aim_timeout_ms must be positive."};
+  }
+  fire_aim_timeout_ = std::chrono::milliseconds(fire_aim_timeout_ms);
+  const double fire_extra_delay_ms = declare_parameter("fire_scheduler.extra_delay_ms", 0.0);
+  fire_extra_delay_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::duration<double, std::milli>(fire_extra_delay_ms));
+
+  attitude_history_size_ = declare_parameter<int>("attitude_history.size", 2000);
+  if (attitude_history_size_ <= 0) {
+    throw std::invalid_argument{"attitude_history.size must be positive."};
+  }
+
+  pid_debug_decimation_ = declare_parameter<int>("pid_debug.decimation", 1);
+  pid_debug_batch_size_ = declare_parameter<int>("pid_debug.batch_size", 1);
+  pid_debug_history_size_ = declare_parameter<int>("pid_debug.history_size", 5000);
+  if (pid_debug_decimation_ < 1 || pid_debug_batch_size_ < 1 || pid_debug_history_size_ < 0) {
+    throw std::invalid_argument{
+      "pid_debug.decimation and pid_debug.batch_size must be positive, "
+      "pid_debug.history_size must be non-negative."};
+  }
+
+  baud_rate_auto_detect_ = declare_parameter("baud_rate_auto_detect", false);
+  baud_rate_candidates_ = declare_parameter<std::vector<int64_t>>(
+    "baud_rate_candidates", std::vector<int64_t>{115200, 230400, 460800, 921600, 2000000, 4000000});
+  baud_rate_detect_window_ =
+    std::chrono::milliseconds(declare_parameter<int>("baud_rate_detect_window_ms", 100));
+
+  receive_timeout_ = std::chrono::milliseconds(declare_parameter<int>("receive_timeout_ms", 1000));
+  shutdown_timeout_ = std::chrono::milliseconds(declare_parameter<int>("shutdown_timeout_ms", 100));
+
+  receive_thread_config_ = getThreadRtParams("receive_thread");
+  send_thread_config_ = getThreadRtParams("send_thread");
+  protect_thread_config_ = getThreadRtParams("protect_thread");
+
+  lock_memory_ = declare_parameter("lock_memory", false);
+  prefault_heap_size_ = declare_parameter<int64_t>("prefault_heap_size", 0);
+  prefault_stack_size_ = declare_parameter<int64_t>("prefault_stack_size", 0);
+  if (prefault_heap_size_ < 0 || prefault_stack_size_ < 0) {
+    throw std::invalid_argument{"prefault_heap_size and prefault_stack_size must be non-negative."};
+  }
+
+  // 需在所有参数声明完成后注册，declare_parameter 同样会触发该回调
+  on_set_parameters_callback_handle_ = add_on_set_parameters_callback(
+    std::bind(&StandardRobotPpRos2Node::onSetParameters, this, std::placeholders::_1));
+}
+
+rcl_interfaces::msg::SetParametersResult StandardRobotPpRos2Node::onSetParameters(
+  const std::vector<rclcpp::Parameter> & parameters)
+{
+  rcl_interfaces::msg::SetParametersResult result;
+  result.successful = true;
+
+  std::lock_guard<std::mutex> lock(link_config_mutex_);
+  std::string device_name = pending_device_config_ ? pending_device_name_ : device_name_;
+  const auto & current_config = pending_device_config_ ? *pending_device_config_ : *device_config_;
+  int64_t baud_rate = current_config.get_baud_rate();
+  auto fc = current_config.get_flow_control();
+  auto pt = current_config.get_parity();
+  auto sb = current_config.get_stop_bits();
+  bool debug = debug_;
+  bool link_changed = false;
+
+  try {
+    for (const auto & parameter : parameters) {
+      const auto & name = parameter.get_name();
+      if (name == "device_name") {
+        device_name = parameter.as_string();
+        link_changed = true;
+      } else if (name == "baud_rate") {
+        baud_rate = parameter.as_int();
+        if (baud_rate <= 0) {
+          throw std::invalid_argument{"The baud_rate parameter must be positive."};
+        }
+        link_changed = true;
+      } else if (name == "flow_control") {
+        fc = toFlowControl(parameter.as_string());
+        link_changed = true;
+      } else if (name == "parity") {
+        pt = toParity(parameter.as_string());
+        link_changed = true;
+      } else if (name == "stop_bits") {
+        sb = toStopBits(parameter.as_string());
+        link_changed = true;
+      } else if (name == "debug") {
+        debug = parameter.as_bool();
+      }
+    }
+  } catch (const std::exception & ex) {
+    result.successful = false;
+    result.reason = ex.what();
+    return result;
+  }
+
+  debug_ = debug;
+
+  if (link_changed) {
+    pending_device_name_ = device_name;
+    pending_device_config_ =
+      std::make_unique<SerialPortConfig>(static_cast<uint32_t>(baud_rate), fc, pt, sb);
+    {
+      std::lock_guard<std::mutex> stop_lock(stop_mutex_);
+      reconfigure_requested_ = true;
+    }
+    stop_cv_.notify_all();
+    RCLCPP_INFO(
+      get_logger(), "Serial link reconfigure requested: %s @ %ld baud", device_name.c_str(),
+      baud_rate);
+  }
+
+  return result;
+}
+
+void StandardRobotPpRos2Node::declareTopicQos(
+  const std::string & key, const TopicQos & defaults, bool with_decimation)
+{
+  const std::string prefix = "qos." + key + ".";
+  TopicQos config;
+  config.reliability = declare_parameter(prefix + "reliability", defaults.reliability);
+  config.durability = declare_parameter(prefix + "durability", defaults.durability);
+  config.depth = declare_parameter<int>(prefix + "depth", defaults.depth);
+  if (with_decimation) {
+    config.decimation = declare_parameter<int>(prefix + "decimation", defaults.decimation);
+  }
+
+  std::string error;
+  if (!isValidTopicQos(config, error)) {
+    throw std::invalid_argument{prefix + "*: " + error};
+  }
+  topic_qos_[key] = config;
+}
+
+bool StandardRobotPpRos2Node::takePendingLinkConfig()
+{
+  std::lock_guard<std::mutex> lock(link_config_mutex_);
+  if (!pending_device_config_) {
+    return false;
+  }
+  device_name_ = pending_device_name_;
+  device_config_ = std::move(pending_device_config_);
+  return true;
+}
+
+ThreadRtConfig StandardRobotPpRos2Node::getThreadRtParams(const std::string & prefix)
+{
+  ThreadRtConfig config;
+
+  config.cpu_affinity =
+    declare_parameter<std::vector<int64_t>>(prefix + ".cpu_affinity", std::vector<int64_t>{});
+  config.sched_policy = declare_parameter<std::string>(prefix + ".sched_policy", "other");
+  config.sched_priority = declare_parameter<int>(prefix + ".sched_priority", 0);
+
+  if (!isValidSchedPolicy(config.sched_policy)) {
+    throw std::invalid_argument{"The " + prefix +
+                                ".sched_policy parameter must be one of: other, fifo, or rr."};
+  }
+
+  return config;
+}
+
+GimbalSimulator::AxisConfig StandardRobotPpRos2Node::getSimulationAxisParams(
+  const std::string & prefix)
+{
+  GimbalSimulator::AxisConfig config;
+  config.natural_frequency =
+    declare_parameter(prefix + ".natural_frequency", config.natural_frequency);
+  config.damping = declare_parameter(prefix + ".damping", config.damping);
+  config.max_velocity = declare_parameter(prefix + ".max_velocity", config.max_velocity);
+  config.max_acceleration =
+    declare_parameter(prefix + ".max_acceleration", config.max_acceleration);
+  config.position_limited =
+    declare_parameter(prefix + ".position_limited", config.position_limited);
+  config.min_position = declare_parameter(prefix + ".min_position", config.min_position);
+  config.max_position = declare_parameter(prefix + ".max_position", config.max_position);
+  config.encoder_resolution =
+    declare_parameter(prefix + ".encoder_resolution", config.encoder_resolution);
+
+  if (
+    config.natural_frequency <= 0.0 || config.damping <= 0.0 || config.max_velocity <= 0.0 ||
+    config.max_acceleration <= 0.0 ||
+    (config.position_limited && config.min_position >= config.max_position) ||
+    config.encoder_resolution < 0.0) {
+    throw std::invalid_argument{"Invalid " + prefix + " parameters."};
+  }
+
+  return config;
+}
+
+/********************************************************/
+/* Real-time                                            */
+/********************************************************/
+void StandardRobotPpRos2Node::configureCurrentThread(
+  const std::string & name, const ThreadRtConfig & config)
+{
+  std::string error;
+  if (applyThreadRtConfig(name, config, error)) {
+    RCLCPP_INFO(
+      get_logger(), "Thread %s: policy=%s, priority=%d, cpu_affinity=%zu cpus", name.c_str(),
+      config.sched_policy.c_str(), config.sched_priority, config.cpu_affinity.size());
+  } else {
+    RCLCPP_ERROR(
+      get_logger(), "Thread %s real-time config failed: %s", name.c_str(), error.c_str());
+  }
+
+  // 栈属于各个线程，需在 I/O 线程自身中触碰
+  if (lock_memory_ && prefault_stack_size_ > 0) {
+    prefaultStack(static_cast<size_t>(prefault_stack_size_));
+    RCLCPP_INFO(
+      get_logger(), "Thread %s: prefaulted stack=%ld bytes", name.c_str(), prefault_stack_size_);
+  }
+}
+
+void StandardRobotPpRos2Node::lockMemory()
+{
+  // mlockall 与 mallopt 作用于整个进程，组合运行时同一容器中的所有组件都受影响
+  std::string error;
+  bool already_locked = false;
+  if (!lockAndPrefaultMemory(static_cast<size_t>(prefault_heap_size_), error, already_locked)) {
+    RCLCPP_ERROR(get_logger(), "Lock memory failed: %s", error.c_str());
+  } else if (already_locked) {
+    RCLCPP_INFO(get_logger(), "Process memory already locked by another component");
+  } else {
+    RCLCPP_WARN(
+      get_logger(),
+      "Locked memory of the whole process (applies to every component in this container), "
+      "prefaulted heap=%ld bytes",
+      prefault_heap_size_);
+  }
+}
+
+/********************************************************/
+/* Thread control                                       */
+/********************************************************/
+bool StandardRobotPpRos2Node::isRunning() const { return rclcpp::ok() && !stop_requested_; }
+
+void StandardRobotPpRos2Node::sleepFor(std::chrono::nanoseconds duration)
+{
+  std::unique_lock<std::mutex> lock(stop_mutex_);
+  stop_cv_.wait_for(lock, duration, [this]() { return stop_requested_.load(); });
+}
+
+void StandardRobotPpRos2Node::startThreads()
+{
+  stop_requested_ = false;
+  serial_port_protect_thread_.start(&StandardRobotPpRos2Node::serialPortProtect, this);
+  receive_thread_.start(&StandardRobotPpRos2Node::receiveData, this);
+  send_thread_.start(&StandardRobotPpRos2Node::sendData, this);
+}
+
+bool StandardRobotPpRos2Node::stopThreads()
+{
+  if (
+    !send_thread_.joinable() && !receive_thread_.joinable() &&
+    !serial_port_protect_thread_.joinable()) {
+    closePort();
+    // 之前超时分离的线程可能仍在运行
+    return threadsFinished();
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  const auto deadline = start + shutdown_timeout_;
+
+  {
+    std::lock_guard<std::mutex> lock(stop_mutex_);
+    stop_requested_ = true;
+  }
+  stop_cv_.notify_all();
+  rx_cv_.notify_all();
+
+  // 关闭串口以取消挂起的异步读取
+  closePort();
+
+  // 三个线程共用一个期限，超时未退出的线程被分离
+  bool stopped = send_thread_.joinUntil(deadline);
+  stopped = receive_thread_.joinUntil(deadline) && stopped;
+  stopped = serial_port_protect_thread_.joinUntil(deadline) && stopped;
+
+  // 保护线程可能在停止请求前刚刚重新打开了串口
+  closePort();
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::steady_clock::now() - start);
+  if (!stopped) {
+    RCLCPP_ERROR(
+      get_logger(), "I/O threads did not stop within shutdown timeout %ld ms, detached",
+      shutdown_timeout_.count());
+  } else {
+    RCLCPP_INFO(get_logger(), "Stop threads took %ld ms", elapsed.count());
+  }
+  return stopped;
+}
+
+bool StandardRobotPpRos2Node::threadsFinished() const
+{
+  return send_thread_.finished() && receive_thread_.finished() &&
+         serial_port_protect_thread_.finished();
 }
 
 /********************************************************/
 /* Serial port protect                                  */
 /********************************************************/
-void StandardRobotPpRos2Node::serialPortProtect()
+bool StandardRobotPpRos2Node::openPort()
 {
-  RCLCPP_INFO(get_logger(), "Start serialPortProtect!");
+  std::lock_guard<std::mutex> lock(port_mutex_);
+  return openPortLocked();
+}
 
-  // @TODO: 1.保持串口连接 2.串口断开重连 3.串口异常处理
+bool StandardRobotPpRos2Node::openPortLocked()
+{
+  if (stop_requested_) {
+    return false;
+  }
+
+  if (simulation_enable_) {
+    simulator_.reset();
+    simulation_time_ = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> rx_lock(rx_mutex_);
+    rx_buffer_.clear();
+    last_receive_time_ = simulation_time_;
+    link_generation_++;
+    return true;
+  }
 
-  // 初始化串口
-  serial_driver_->init_port(device_name_, *device_config_);
-  // 尝试打开串口
+  auto port = serial_driver_->port();
+  if (port->is_open()) {
+    port->close();
+  }
+  port->open();
+  if (!port->is_open()) {
+    return false;
+  }
+
+  {
+    std::lock_guard<std::mutex> rx_lock(rx_mutex_);
+    rx_buffer_.clear();
+    last_receive_time_ = std::chrono::steady_clock::now();
+    link_generation_++;
+  }
+  port->async_receive(
+    [this](std::vector<uint8_t> & buffer, const size_t & bytes_transferred) {
+      onReceive(buffer, bytes_transferred);
+    });
+  return true;
+}
+
+void StandardRobotPpRos2Node::closePort()
+{
+  std::lock_guard<std::mutex> lock(port_mutex_);
+  auto port = serial_driver_->port();
+  if (!port || !port->is_open()) {
+    return;
+  }
   try {
-    if (!serial_driver_->port()->is_open()) {
-      serial_driver_->port()->open();
-      RCLCPP_INFO(get_logger(), "Serial port opened!");
-      is_usb_ok_ = true;
+    port->close();
+  } catch (const std::exception & ex) {
+    RCLCPP_ERROR(get_logger(), "Close serial port failed : %s", ex.what());
+  }
+}
+
+void StandardRobotPpRos2Node::reopenLink()
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  // 等待接收线程解析完旧链路上已读取的数据
+  for (int i = 0; i < RECEIVE_WAIT_TIME; ++i) {
+    {
+      std::lock_guard<std::mutex> lock(rx_mutex_);
+      if (rx_buffer_.empty()) {
+        break;
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  // 持有 port_mutex_ 期间发送线程阻塞等待，不会写入已关闭的串口
+  bool opened = false;
+  try {
+    std::lock_guard<std::mutex> lock(port_mutex_);
+    auto port = serial_driver_->port();
+    if (port && port->is_open()) {
+      port->close();
     }
+    takePendingLinkConfig();
+    serial_driver_->init_port(device_name_, *device_config_);
+    opened = openPortLocked();
   } catch (const std::exception & ex) {
-    RCLCPP_ERROR(get_logger(), "Open serial port failed : %s", ex.what());
-    is_usb_ok_ = false;
+    RCLCPP_ERROR(get_logger(), "Reopen serial port failed : %s", ex.what());
   }
+  is_usb_ok_ = opened;
+
+  const auto elapsed = std::chrono::duration<double, std::milli>(
+    std::chrono::steady_clock::now() - start);
+  if (opened) {
+    RCLCPP_INFO(
+      get_logger(), "Serial link switched to %s @ %u baud in %.3f ms", device_name_.c_str(),
+      device_config_->get_baud_rate(), elapsed.count());
+  } else {
+    RCLCPP_ERROR(
+      get_logger(), "Serial link switch to %s failed after %.3f ms, retrying",
+      device_name_.c_str(), elapsed.count());
+  }
+}
+
+void StandardRobotPpRos2Node::detectBaudRate()
+{
+  const auto start = std::chrono::steady_clock::now();
+  const auto & config = *device_config_;
+
+  uint32_t best_baud_rate = 0;
+  int best_count = 0;
+  std::string summary;
+
+  for (const auto candidate : baud_rate_candidates_) {
+    if (candidate <= 0) {
+      continue;
+    }
+    const auto baud_rate = static_cast<uint32_t>(candidate);
+    int count = 0;
+    try {
+      {
+        std::lock_guard<std::mutex> lock(port_mutex_);
+        serial_driver_->init_port(
+          device_name_, SerialPortConfig(
+                          baud_rate, config.get_flow_control(), config.get_parity(),
+                          config.get_stop_bits()));
+        openPortLocked();
+      }
+      std::this_thread::sleep_for(baud_rate_detect_window_);
+      closePort();
+
+      std::vector<uint8_t> data;
+      {
+        std::lock_guard<std::mutex> lock(rx_mutex_);
+        data.swap(rx_buffer_);
+      }
+      count = countValidHeaderFrames(data);
+    } catch (const std::exception & ex) {
+      RCLCPP_WARN(get_logger(), "Baud rate %u probe failed : %s", baud_rate, ex.what());
+      closePort();
+    }
+
+    summary += (summary.empty() ? "" : ", ") + std::to_string(baud_rate) + "=" +
+               std::to_string(count);
+    if (count > best_count) {
+      best_count = count;
+      best_baud_rate = baud_rate;
+    }
+  }
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::steady_clock::now() - start);
+  if (best_count == 0) {
+    RCLCPP_WARN(
+      get_logger(), "Baud rate auto-detect found no valid frame [%s] in %ld ms, keep %u",
+      summary.c_str(), elapsed.count(), config.get_baud_rate());
+    return;
+  }
+
+  RCLCPP_INFO(
+    get_logger(), "Baud rate auto-detect [%s] in %ld ms, use %u", summary.c_str(), elapsed.count(),
+    best_baud_rate);
+  device_config_ = std::make_unique<SerialPortConfig>(
+    best_baud_rate, config.get_flow_control(), config.get_parity(), config.get_stop_bits());
+
+  // 写回 baud_rate 参数，参数回调生成的重连请求与当前配置相同，直接取出丢弃
+  const auto result =
+    set_parameter(rclcpp::Parameter("baud_rate", static_cast<int64_t>(best_baud_rate)));
+  if (!result.successful) {
+    RCLCPP_WARN(get_logger(), "Update baud_rate parameter failed : %s", result.reason.c_str());
+  }
+  takePendingLinkConfig();
+  reconfigure_requested_ = false;
+}
+
+void StandardRobotPpRos2Node::serialPortProtect()
+{
+  RCLCPP_INFO(get_logger(), "Start serialPortProtect!");
+
+  configureCurrentThread("sr_protect", protect_thread_config_);
 
-  is_usb_ok_ = true;
-  std::this_thread::sleep_for(std::chrono::milliseconds(USB_PROTECT_SLEEP_TIME));
+  // @TODO: 1.保持串口连接 2.串口断开重连 3.串口异常处理
+
+  while (isRunning()) {
+    if (reconfigure_requested_.exchange(false)) {
+      reopenLink();
+    }
 
-  while (rclcpp::ok()) {
     if (!is_usb_ok_) {
       try {
-        if (serial_driver_->port()->is_open()) {
-          serial_driver_->port()->close();
-        }
-
-        serial_driver_->port()->open();
-
-        if (serial_driver_->port()->is_open()) {
+        if (openPort()) {
           RCLCPP_INFO(get_logger(), "Serial port opened!");
           is_usb_ok_ = true;
         }
@@ -247,8 +1169,11 @@ void StandardRobotPpRos2Node::serialPortProtect()
       }
     }
 
-    // thread sleep
-    std::this_thread::sleep_for(std::chrono::milliseconds(USB_PROTECT_SLEEP_TIME));
+    // thread sleep，参数修改时立即唤醒
+    std::unique_lock<std::mutex> lock(stop_mutex_);
+    stop_cv_.wait_for(lock, std::chrono::milliseconds(USB_PROTECT_SLEEP_TIME), [this]() {
+      return stop_requested_ || reconfigure_requested_;
+    });
   }
 }
 
@@ -256,184 +1181,395 @@ void StandardRobotPpRos2Node::serialPortProtect()
 /* Receive data                                         */
 /********************************************************/
 
+void StandardRobotPpRos2Node::onReceive(
+  std::vector<uint8_t> & buffer, const size_t & bytes_transferred)
+{
+  {
+    std::lock_guard<std::mutex> lock(rx_mutex_);
+    rx_buffer_.insert(rx_buffer_.end(), buffer.begin(), buffer.begin() + bytes_transferred);
+    last_receive_time_ = std::chrono::steady_clock::now();
+    last_receive_host_ns_ = now().nanoseconds();
+  }
+  rx_cv_.notify_one();
+}
+
 void StandardRobotPpRos2Node::receiveData()
 {
   RCLCPP_INFO(get_logger(), "Start receiveData!");
 
-  std::vector<uint8_t> sof(1);
+  configureCurrentThread("sr_receive", receive_thread_config_);
+
+  // 异步读取回调写入 rx_buffer_，本线程取出后追加到 receive_data 中按帧解析
+  std::vector<uint8_t> incoming;
   std::vector<uint8_t> receive_data;
 
+  uint64_t link_generation = 0;
+
   int sof_count = 0;
   int retry_count = 0;
 
-  while (rclcpp::ok()) {
+  while (isRunning()) {
     if (!is_usb_ok_) {
       RCLCPP_WARN(get_logger(), "receive: usb is not ok! Retry count: %d", retry_count++);
-      std::this_thread::sleep_for(std::chrono::milliseconds(USB_NOT_OK_SLEEP_TIME));
+      receive_data.clear();
+      sleepFor(std::chrono::milliseconds(USB_NOT_OK_SLEEP_TIME));
       continue;
     }
 
-    try {
-      serial_driver_->port()->receive(sof);
+    std::chrono::steady_clock::time_point last_receive_time;
+    int64_t receive_host_ns = 0;
+    {
+      std::unique_lock<std::mutex> lock(rx_mutex_);
+      rx_cv_.wait_for(lock, std::chrono::milliseconds(RECEIVE_WAIT_TIME), [this]() {
+        return !rx_buffer_.empty() || stop_requested_;
+      });
+      incoming.swap(rx_buffer_);
+      last_receive_time = last_receive_time_;
+      receive_host_ns = last_receive_host_ns_;
+      // 串口重新打开后丢弃旧链路残留的半帧数据，下位机可能已重启，时钟需要重新同步
+      if (link_generation != link_generation_) {
+        link_generation = link_generation_;
+        receive_data.clear();
+        mcu_clock_.reset();
+      }
+    }
+
+    if (incoming.empty()) {
+      // 异步读取出错后不会再回调，长时间无数据时交由保护线程重新打开串口
+      if (std::chrono::steady_clock::now() - last_receive_time > receive_timeout_) {
+        RCLCPP_ERROR(
+          get_logger(), "No data received for %ld ms, reopen serial port",
+          receive_timeout_.count());
+        is_usb_ok_ = false;
+      }
+      continue;
+    }
 
-      if (sof[0] != SOF_RECEIVE) {
+    receive_data.insert(receive_data.end(), incoming.begin(), incoming.end());
+    incoming.clear();
+
+    size_t pos = 0;
+    while (receive_data.size() - pos >= sizeof(HeaderFrame)) {
+      uint8_t * frame = receive_data.data() + pos;
+
+      if (frame[0] != SOF_RECEIVE) {
         sof_count++;
-        RCLCPP_INFO(get_logger(), "Find sof, cnt=%d", sof_count);
+        RCLCPP_WARN_THROTTLE(get_logger(), *get_clock(), 1000, "Find sof, cnt=%d", sof_count);
+        pos++;
         continue;
       }
 
       // Reset sof_count when SOF_RECEIVE is found
       sof_count = 0;
 
-      // sof[0] == SOF_RECEIVE 后读取剩余 header_frame 内容
-      std::vector<uint8_t> header_frame_buf(3);  // sof 在读取完数据后添加
-
-      serial_driver_->port()->receive(header_frame_buf);  // 读取除 sof 外剩下的数据
-      header_frame_buf.insert(header_frame_buf.begin(), sof[0]);  // 添加 sof
-      HeaderFrame header_frame = fromVector<HeaderFrame>(header_frame_buf);
-
       // HeaderFrame CRC8 check
-      bool crc8_ok = crc8::verify_CRC8_check_sum(
-        reinterpret_cast<uint8_t *>(&header_frame), sizeof(header_frame));
+      HeaderFrame header_frame = fromBytes<HeaderFrame>(frame, sizeof(HeaderFrame));
+      bool crc8_ok = crc8::verify_CRC8_check_sum(frame, sizeof(HeaderFrame));
       if (!crc8_ok) {
         RCLCPP_ERROR(get_logger(), "Header frame CRC8 error!");
+        pos++;
         continue;
       }
 
-      // crc8_ok 校验正确后读取数据段
-      // 根据数据段长度读取数据
-      std::vector<uint8_t> data_buf(header_frame.len + 2);  // len + crc
-      int received_len = serial_driver_->port()->receive(data_buf);
-      int received_len_sum = received_len;
-      // 考虑到一次性读取数据可能存在数据量过大，读取不完整的情况。需要检测是否读取完整
-      // 计算剩余未读取的数据长度
-      int remain_len = header_frame.len + 2 - received_len;
-      while (remain_len > 0) {  // 读取剩余未读取的数据
-        std::vector<uint8_t> remain_buf(remain_len);
-        received_len = serial_driver_->port()->receive(remain_buf);
-        data_buf.insert(data_buf.begin() + received_len_sum, remain_buf.begin(), remain_buf.end());
-        received_len_sum += received_len;
-        remain_len -= received_len;
+      // 根据数据段长度等待完整数据包 (header + len + crc16)
+      const size_t frame_len = sizeof(HeaderFrame) + header_frame.len + 2;
+      if (receive_data.size() - pos < frame_len) {
+        break;
       }
 
-      // 数据段读取完成后添加 header_frame_buf 到 data_buf，得到完整数据包
-      data_buf.insert(data_buf.begin(), header_frame_buf.begin(), header_frame_buf.end());
-
       // 整包数据校验
-      bool crc16_ok = crc16::verify_CRC16_check_sum(data_buf);
+      bool crc16_ok = crc16::verify_CRC16_check_sum(frame, frame_len);
       if (!crc16_ok) {
         RCLCPP_ERROR(get_logger(), "Data segment CRC16 error!");
+        pos++;
         continue;
       }
 
-      // crc16_ok 校验正确后根据 header_frame.id 解析数据
-      switch (header_frame.id) {
-        case ID_DEBUG: {
-          ReceiveDebugData debug_data = fromVector<ReceiveDebugData>(data_buf);
-          publishDebugData(debug_data);
-        } break;
-        case ID_IMU: {
-          ReceiveImuData imu_data = fromVector<ReceiveImuData>(data_buf);
-          publishImuData(imu_data);
-        } break;
-        case ID_ROBOT_STATE_INFO: {
-          ReceiveRobotInfoData robot_info_data = fromVector<ReceiveRobotInfoData>(data_buf);
-          publishRobotInfo(robot_info_data);
-        } break;
-        case ID_EVENT_DATA: {
-          ReceiveEventData event_data = fromVector<ReceiveEventData>(data_buf);
-          publishEventData(event_data);
-        } break;
-        case ID_PID_DEBUG: {
-          RCLCPP_WARN(get_logger(), "Not implemented yet!");
-        } break;
-        case ID_ALL_ROBOT_HP: {
-          ReceiveAllRobotHpData all_robot_hp_data = fromVector<ReceiveAllRobotHpData>(data_buf);
-          publishAllRobotHp(all_robot_hp_data);
-        } break;
-        case ID_GAME_STATUS: {
-          ReceiveGameStatusData game_status_data = fromVector<ReceiveGameStatusData>(data_buf);
-          publishGameStatus(game_status_data);
-        } break;
-        case ID_ROBOT_MOTION: {
-          ReceiveRobotMotionData robot_motion_data = fromVector<ReceiveRobotMotionData>(data_buf);
-          publishRobotMotion(robot_motion_data);
-        } break;
-        case ID_GROUND_ROBOT_POSITION: {
-          ReceiveGroundRobotPosition ground_robot_position_data =
-            fromVector<ReceiveGroundRobotPosition>(data_buf);
-          publishGroundRobotPosition(ground_robot_position_data);
-        } break;
-        case ID_RFID_STATUS: {
-          ReceiveRfidStatus rfid_status_data = fromVector<ReceiveRfidStatus>(data_buf);
-          publishRfidStatus(rfid_status_data);
-        } break;
-        case ID_ROBOT_STATUS: {
-          ReceiveRobotStatus robot_status_data = fromVector<ReceiveRobotStatus>(data_buf);
-          publishRobotStatus(robot_status_data);
-        } break;
-        case ID_JOINT_STATE: {
-          ReceiveJointState joint_state_data = fromVector<ReceiveJointState>(data_buf);
-          publishJointState(joint_state_data);
-        } break;
-        case ID_BUFF: {
-          ReceiveBuff buff = fromVector<ReceiveBuff>(data_buf);
-          publishBuff(buff);
-        } break;
-        default: {
-          RCLCPP_WARN(get_logger(), "Invalid id: %d", header_frame.id);
-        } break;
+      // 所有数据包的数据段均以下位机时间戳开头
+      if (header_frame.len >= sizeof(uint32_t)) {
+        uint32_t time_stamp;
+        std::memcpy(&time_stamp, frame + sizeof(HeaderFrame), sizeof(time_stamp));
+        mcu_clock_.update(time_stamp, receive_host_ns);
       }
-    } catch (const std::exception & ex) {
-      RCLCPP_ERROR(get_logger(), "Error receiving data: %s", ex.what());
-      is_usb_ok_ = false;
+
+      // 非 active 状态下仅排空串口数据，不发布
+      if (is_active_) {
+        processFrame(header_frame.id, frame, frame_len);
+      }
+      pos += frame_len;
     }
+    receive_data.erase(receive_data.begin(), receive_data.begin() + pos);
+  }
+}
+
+void StandardRobotPpRos2Node::processFrame(uint8_t id, const uint8_t * frame, size_t len)
+{
+  // crc16_ok 校验正确后根据 header_frame.id 解析数据
+  switch (id) {
+    case ID_DEBUG: {
+      ReceiveDebugData debug_data = fromBytes<ReceiveDebugData>(frame, len);
+      publishDebugData(debug_data);
+    } break;
+    case ID_IMU: {
+      ReceiveImuData imu_data = fromBytes<ReceiveImuData>(frame, len);
+      publishImuData(imu_data);
+    } break;
+    case ID_ROBOT_STATE_INFO: {
+      ReceiveRobotInfoData robot_info_data = fromBytes<ReceiveRobotInfoData>(frame, len);
+      publishRobotInfo(robot_info_data);
+    } break;
+    case ID_EVENT_DATA: {
+      ReceiveEventData event_data = fromBytes<ReceiveEventData>(frame, len);
+      publishEventData(event_data);
+    } break;
+    case ID_PID_DEBUG: {
+      ReceivePidDebugData pid_debug_data = fromBytes<ReceivePidDebugData>(frame, len);
+      publishPidDebugData(pid_debug_data);
+    } break;
+    case ID_ALL_ROBOT_HP: {
+      ReceiveAllRobotHpData all_robot_hp_data = fromBytes<ReceiveAllRobotHpData>(frame, len);
+      publishAllRobotHp(all_robot_hp_data);
+    } break;
+    case ID_GAME_STATUS: {
+      ReceiveGameStatusData game_status_data = fromBytes<ReceiveGameStatusData>(frame, len);
+      publishGameStatus(game_status_data);
+    } break;
+    case ID_ROBOT_MOTION: {
+      ReceiveRobotMotionData robot_motion_data = fromBytes<ReceiveRobotMotionData>(frame, len);
+      publishRobotMotion(robot_motion_data);
+    } break;
+    case ID_GROUND_ROBOT_POSITION: {
+      ReceiveGroundRobotPosition ground_robot_position_data =
+        fromBytes<ReceiveGroundRobotPosition>(frame, len);
+      publishGroundRobotPosition(ground_robot_position_data);
+    } break;
+    case ID_RFID_STATUS: {
+      ReceiveRfidStatus rfid_status_data = fromBytes<ReceiveRfidStatus>(frame, len);
+      publishRfidStatus(rfid_status_data);
+    } break;
+    case ID_ROBOT_STATUS: {
+      ReceiveRobotStatus robot_status_data = fromBytes<ReceiveRobotStatus>(frame, len);
+      publishRobotStatus(robot_status_data);
+    } break;
+    case ID_JOINT_STATE: {
+      ReceiveJointState joint_state_data = fromBytes<ReceiveJointState>(frame, len);
+      publishJointState(joint_state_data);
+    } break;
+    case ID_BUFF: {
+      ReceiveBuff buff = fromBytes<ReceiveBuff>(frame, len);
+      publishBuff(buff);
+    } break;
+    case ID_IMU_RAW: {
+      ReceiveImuRawData imu_raw_data = fromBytes<ReceiveImuRawData>(frame, len);
+      publishImuRawData(imu_raw_data, len);
+    } break;
+    default: {
+      RCLCPP_WARN(get_logger(), "Invalid id: %d", id);
+    } break;
+  }
+}
+
+void StandardRobotPpRos2Node::internDebugChannel(DebugChannel & channel, const uint8_t * name)
+{
+  std::copy(name, name + DEBUG_PACKAGE_NAME_LEN, channel.name_bytes.begin());
+
+  // 名称以 0 结尾，未以 0 结尾时取全部字节
+  const auto name_end = std::find(name, name + DEBUG_PACKAGE_NAME_LEN, 0);
+  channel.name.assign(name, name_end);
+
+  debug_batch_names_changed_ = true;
+
+  // 批量模式下所有通道合并发布，不创建单通道发布者
+  if (channel.name.empty() || debug_batched_) {
+    channel.publisher.reset();
+    return;
+  }
+
+  if (debug_pub_map_.find(channel.name) == debug_pub_map_.end()) {
+    createNewDebugPublisher(channel.name);
   }
+  channel.publisher = debug_pub_map_.at(channel.name);
 }
 
 void StandardRobotPpRos2Node::publishDebugData(ReceiveDebugData & received_debug_data)
 {
-  static rclcpp::Publisher<example_interfaces::msg::Float64>::SharedPtr debug_pub;
-  for (auto & package : received_debug_data.packages) {
-    // Create a vector to hold the non-zero data
-    std::vector<uint8_t> non_zero_data;
-    for (unsigned char name : package.name) {
-      if (name != 0) {
-        non_zero_data.push_back(name);
-      } else {
-        break;
-      }
+  if (!debug_) {
+    return;
+  }
+
+  for (size_t i = 0; i < DEBUG_PACKAGE_NUM; i++) {
+    const auto & package = received_debug_data.packages[i];
+    auto & channel = debug_channels_[i];
+
+    // 仅在槽位名称字节变化时重新查找发布者
+    if (std::memcmp(channel.name_bytes.data(), package.name, DEBUG_PACKAGE_NAME_LEN) != 0) {
+      internDebugChannel(channel, package.name);
     }
-    // Convert the non-zero data to a string
-    std::string name(non_zero_data.begin(), non_zero_data.end());
 
-    if (name.empty()) {
+    if (debug_batched_ || !channel.publisher) {
       continue;
     }
 
-    if (debug_) {
-      if (debug_pub_map_.find(name) == debug_pub_map_.end()) {
-        createNewDebugPublisher(name);
+    example_interfaces::msg::Float64 msg;
+    msg.data = package.data;
+    channel.publisher->publish(msg);
+  }
+
+  if (debug_batched_) {
+    publishDebugBatch(received_debug_data);
+  }
+}
+
+void StandardRobotPpRos2Node::publishDebugBatch(ReceiveDebugData & received_debug_data)
+{
+  auto & msg = debug_batch_msg_;
+
+  // 行标签为以逗号分隔的通道名，仅在槽位名称变化时重建
+  if (debug_batch_names_changed_) {
+    auto & label = msg.layout.dim[0].label;
+    label.clear();
+    for (const auto & channel : debug_channels_) {
+      if (channel.name.empty()) {
+        continue;
       }
-      debug_pub = debug_pub_map_.at(name);
+      label += (label.empty() ? "" : ",") + channel.name;
+    }
+    debug_batch_names_changed_ = false;
+  }
 
-      example_interfaces::msg::Float64 msg;
-      msg.data = package.data;
-      debug_pub->publish(msg);
+  // 每行依次为下位机时间戳 (ms)、数值、数据类型
+  msg.data.clear();
+  for (size_t i = 0; i < DEBUG_PACKAGE_NUM; i++) {
+    if (debug_channels_[i].name.empty()) {
+      continue;
     }
+    msg.data.push_back(received_debug_data.time_stamp);
+    msg.data.push_back(received_debug_data.packages[i].data);
+    msg.data.push_back(received_debug_data.packages[i].type);
+  }
+
+  const size_t channel_num = msg.data.size() / 3;
+  msg.layout.dim[0].size = channel_num;
+  msg.layout.dim[0].stride = channel_num * 3;
+  debug_batch_pub_->publish(msg);
+}
+
+void StandardRobotPpRos2Node::publishPidDebugData(ReceivePidDebugData & pid_debug_data)
+{
+  const PidDebugSample sample{
+    pid_debug_data.time_stamp, pid_debug_data.data.fdb, pid_debug_data.data.ref,
+    pid_debug_data.data.pid_out};
+
+  // 全速率样本写入历史缓冲区，供服务一次性导出
+  {
+    std::lock_guard<std::mutex> lock(pid_debug_history_mutex_);
+    pid_debug_history_.push(sample);
+  }
+
+  if (++pid_debug_sample_count_ < pid_debug_decimation_) {
+    return;
+  }
+  pid_debug_sample_count_ = 0;
+
+  auto & msg = pid_debug_msg_;
+  msg.data.push_back(sample.time_stamp);
+  msg.data.push_back(sample.fdb);
+  msg.data.push_back(sample.ref);
+  msg.data.push_back(sample.pid_out);
+
+  const size_t sample_num = msg.data.size() / 4;
+  if (sample_num < static_cast<size_t>(pid_debug_batch_size_)) {
+    return;
+  }
+
+  msg.layout.dim[0].size = sample_num;
+  msg.layout.dim[0].stride = sample_num * 4;
+  pid_debug_pub_->publish(msg);
+  msg.data.clear();
+}
+
+void StandardRobotPpRos2Node::dumpPidDebugHistory(
+  const example_interfaces::srv::Trigger::Request::SharedPtr /*request*/,
+  example_interfaces::srv::Trigger::Response::SharedPtr response)
+{
+  std::lock_guard<std::mutex> lock(pid_debug_history_mutex_);
+
+  std::string & csv = response->message;
+  csv.reserve(pid_debug_history_.size() * 48 + 32);
+  csv = "time_stamp_ms,fdb,ref,pid_out\n";
+  char line[96];
+  for (size_t i = 0; i < pid_debug_history_.size(); i++) {
+    const auto & sample = pid_debug_history_.at(i);
+    snprintf(
+      line, sizeof(line), "%u,%.9g,%.9g,%.9g\n", sample.time_stamp, sample.fdb, sample.ref,
+      sample.pid_out);
+    csv += line;
+  }
+  response->success = !pid_debug_history_.empty();
+}
+
+void StandardRobotPpRos2Node::getAttitude(
+  const srv::GetAttitude::Request::SharedPtr request,
+  srv::GetAttitude::Response::SharedPtr response)
+{
+  const auto history = attitude_history_;
+  if (!history) {
+    response->success = false;
+    response->message = "attitude history not configured";
+    return;
+  }
+
+  const int64_t stamp_ns = rclcpp::Time(request->stamp).nanoseconds();
+  tf2::Quaternion orientation;
+  double pitch;
+  double yaw;
+  if (!history->orientationAt(stamp_ns, orientation)) {
+    response->success = false;
+    response->message = "stamp outside IMU orientation history";
+    return;
+  }
+  if (!history->jointAt(stamp_ns, pitch, yaw)) {
+    response->success = false;
+    response->message = "stamp outside gimbal joint history";
+    return;
   }
+
+  response->success = true;
+  response->orientation = tf2::toMsg(orientation);
+  response->pitch = pitch;
+  response->yaw = yaw;
+}
+
+rclcpp::Time StandardRobotPpRos2Node::hostStamp(uint32_t mcu_ms)
+{
+  // 所有带下位机时间戳的消息统一使用同步后的上位机时间，未同步时使用当前时间
+  return mcu_clock_.isSynced()
+           ? rclcpp::Time(mcu_clock_.toHostNs(mcu_ms), get_clock()->get_clock_type())
+           : now();
 }
 
 void StandardRobotPpRos2Node::publishImuData(ReceiveImuData & imu_data)
 {
-  sensor_msgs::msg::Imu msg;
   // Convert Euler angles to quaternion
   tf2::Quaternion q;
   q.setRPY(imu_data.data.roll, imu_data.data.pitch, imu_data.data.yaw);
+
+  // 历史缓冲区与里程计使用全速率数据，不受降频影响
+  if (mcu_clock_.isSynced()) {
+    attitude_history_->pushOrientation(mcu_clock_.toHostNs(imu_data.time_stamp), q);
+  }
+  if (odometry_enable_) {
+    odometry_integrator_.updateImu(imu_data.time_stamp, imu_data.data.yaw_vel);
+  }
+
+  if (!imu_decimator_.tick()) {
+    return;
+  }
+
+  // 复用预先填好 frame_id 与协方差的消息
+  auto & msg = imu_msg_;
   // Set the header
-  msg.header.stamp.sec = imu_data.time_stamp / 1000;
-  msg.header.stamp.nanosec = (imu_data.time_stamp % 1000) * 1e6;
-  msg.header.frame_id = "odom";
+  msg.header.stamp = hostStamp(imu_data.time_stamp);
   // Set the orientation
   msg.orientation.x = q.x();
   msg.orientation.y = q.y();
@@ -443,34 +1579,99 @@ void StandardRobotPpRos2Node::publishImuData(ReceiveImuData & imu_data)
   msg.angular_velocity.x = imu_data.data.roll_vel;
   msg.angular_velocity.y = imu_data.data.pitch_vel;
   msg.angular_velocity.z = imu_data.data.yaw_vel;
-  // Set the linear acceleration
-  // msg.linear_acceleration.x = imu_data.data.x_accel;
-  // msg.linear_acceleration.y = imu_data.data.y_accel;
-  // msg.linear_acceleration.z = imu_data.data.z_accel;
+  // 姿态数据包不含加速度，使用最近的原始数据包；没有时按 REP 145 将协方差首元素置为 -1
+  const bool accel_fresh =
+    has_imu_raw_ && static_cast<uint32_t>(imu_data.time_stamp - imu_raw_time_stamp_) <=
+                      IMU_RAW_ACCEL_TIMEOUT;
+  if (accel_fresh) {
+    msg.linear_acceleration = latest_accel_;
+    msg.linear_acceleration_covariance = imu_raw_msg_.linear_acceleration_covariance;
+  } else {
+    msg.linear_acceleration = geometry_msgs::msg::Vector3();
+    msg.linear_acceleration_covariance[0] = -1.0;
+  }
   // Publish the message
   imu_pub_->publish(msg);
 }
 
+void StandardRobotPpRos2Node::publishImuRawData(ReceiveImuRawData & imu_raw_data, size_t len)
+{
+  // 按实际收到的字节数限制采样数，防止下位机批量大小与上位机不一致时读到空数据
+  const size_t header_len = offsetof(ReceiveImuRawData, data.samples);
+  const size_t received_num =
+    len > header_len + sizeof(uint16_t)
+      ? (len - header_len - sizeof(uint16_t)) / sizeof(imu_raw_data.data.samples[0])
+      : 0;
+  const size_t sample_num = std::min<size_t>(
+    std::min<size_t>(imu_raw_data.data.sample_num, IMU_RAW_BATCH_SIZE), received_num);
+  if (sample_num == 0) {
+    return;
+  }
+
+  const int64_t first_stamp_ns = hostStamp(imu_raw_data.time_stamp).nanoseconds();
+  const int64_t period_ns = static_cast<int64_t>(imu_raw_data.data.sample_period_us) * 1000;
+
+  auto & msg = imu_raw_msg_;
+  for (size_t i = 0; i < sample_num; i++) {
+    const auto & sample = imu_raw_data.data.samples[i];
+    if (!imu_raw_decimator_.tick()) {
+      continue;
+    }
+    msg.header.stamp = rclcpp::Time(first_stamp_ns + period_ns * static_cast<int64_t>(i));
+    msg.angular_velocity.x = sample.gyro_x;
+    msg.angular_velocity.y = sample.gyro_y;
+    msg.angular_velocity.z = sample.gyro_z;
+    msg.linear_acceleration.x = sample.accel_x;
+    msg.linear_acceleration.y = sample.accel_y;
+    msg.linear_acceleration.z = sample.accel_z;
+    imu_raw_pub_->publish(msg);
+  }
+
+  const auto & last = imu_raw_data.data.samples[sample_num - 1];
+  latest_accel_.x = last.accel_x;
+  latest_accel_.y = last.accel_y;
+  latest_accel_.z = last.accel_z;
+  imu_raw_time_stamp_ =
+    imu_raw_data.time_stamp + (imu_raw_data.data.sample_period_us * (sample_num - 1)) / 1000;
+  has_imu_raw_ = true;
+}
+
 void StandardRobotPpRos2Node::publishRobotInfo(ReceiveRobotInfoData & robot_info)
 {
+  if (!robot_state_info_decimator_.tick()) {
+    return;
+  }
+
+  // 型号与状态几乎不变，未变化时跳过消息构造与字符串拷贝
+  if (!robot_state_info_change_.shouldPublish(robot_info.data, ChangeDetector::Clock::now())) {
+    return;
+  }
+
   pb_rm_interfaces::msg::RobotStateInfo msg;
 
-  msg.header.stamp.sec = robot_info.time_stamp / 1000;
-  msg.header.stamp.nanosec = (robot_info.time_stamp % 1000) * 1e6;
+  msg.header.stamp = hostStamp(robot_info.time_stamp);
   msg.header.frame_id = "odom";
 
-  msg.models.chassis = robot_models_.chassis.at(robot_info.data.type.chassis);
-  msg.models.gimbal = robot_models_.gimbal.at(robot_info.data.type.gimbal);
-  msg.models.shoot = robot_models_.shoot.at(robot_info.data.type.shoot);
-  msg.models.arm = robot_models_.arm.at(robot_info.data.type.arm);
+  msg.models.chassis = modelName(CHASSIS_MODELS, robot_info.data.type.chassis);
+  msg.models.gimbal = modelName(GIMBAL_MODELS, robot_info.data.type.gimbal);
+  msg.models.shoot = modelName(SHOOT_MODELS, robot_info.data.type.shoot);
+  msg.models.arm = modelName(ARM_MODELS, robot_info.data.type.arm);
   msg.models.custom_controller =
-    robot_models_.custom_controller.at(robot_info.data.type.custom_controller);
+    modelName(CUSTOM_CONTROLLER_MODELS, robot_info.data.type.custom_controller);
 
   robot_state_info_pub_->publish(msg);
 }
 
 void StandardRobotPpRos2Node::publishEventData(ReceiveEventData & event_data)
 {
+  if (!event_data_decimator_.tick()) {
+    return;
+  }
+
+  if (!event_data_change_.shouldPublish(event_data.data, ChangeDetector::Clock::now())) {
+    return;
+  }
+
   pb_rm_interfaces::msg::EventData msg;
 
   msg.non_overlapping_supply_zone = event_data.data.non_overlapping_supply_zone;
@@ -490,6 +1691,14 @@ void StandardRobotPpRos2Node::publishEventData(ReceiveEventData & event_data)
 
 void StandardRobotPpRos2Node::publishAllRobotHp(ReceiveAllRobotHpData & all_robot_hp)
 {
+  if (!all_robot_hp_decimator_.tick()) {
+    return;
+  }
+
+  if (!all_robot_hp_change_.shouldPublish(all_robot_hp.data, ChangeDetector::Clock::now())) {
+    return;
+  }
+
   pb_rm_interfaces::msg::GameRobotHP msg;
 
   msg.red_1_robot_hp = all_robot_hp.data.red_1_robot_hp;
@@ -513,6 +1722,14 @@ void StandardRobotPpRos2Node::publishAllRobotHp(ReceiveAllRobotHpData & all_robo
 
 void StandardRobotPpRos2Node::publishGameStatus(ReceiveGameStatusData & game_status)
 {
+  if (!game_status_decimator_.tick()) {
+    return;
+  }
+
+  if (!game_status_change_.shouldPublish(game_status.data, ChangeDetector::Clock::now())) {
+    return;
+  }
+
   pb_rm_interfaces::msg::GameStatus msg;
 
   msg.game_progress = game_status.data.game_progress;
@@ -523,6 +1740,18 @@ void StandardRobotPpRos2Node::publishGameStatus(ReceiveGameStatusData & game_sta
 
 void StandardRobotPpRos2Node::publishRobotMotion(ReceiveRobotMotionData & robot_motion)
 {
+  if (odometry_enable_) {
+    const auto & speed = robot_motion.data.speed_vector;
+    odometry_integrator_.updateMotion(robot_motion.time_stamp, speed.vx, speed.vy, speed.wz);
+    if (odometry_decimator_.tick()) {
+      publishOdometry(robot_motion.time_stamp);
+    }
+  }
+
+  if (!robot_motion_decimator_.tick()) {
+    return;
+  }
+
   geometry_msgs::msg::Twist msg;
 
   msg.linear.x = robot_motion.data.speed_vector.vx;
@@ -532,9 +1761,39 @@ void StandardRobotPpRos2Node::publishRobotMotion(ReceiveRobotMotionData & robot_
   robot_motion_pub_->publish(msg);
 }
 
+void StandardRobotPpRos2Node::publishOdometry(uint32_t time_stamp)
+{
+  const rclcpp::Time stamp = hostStamp(time_stamp);
+  const auto orientation =
+    tf2::toMsg(tf2::Quaternion(tf2::Vector3(0, 0, 1), odometry_integrator_.yaw()));
+
+  auto & msg = odometry_msg_;
+  msg.header.stamp = stamp;
+  msg.pose.pose.position.x = odometry_integrator_.x();
+  msg.pose.pose.position.y = odometry_integrator_.y();
+  msg.pose.pose.orientation = orientation;
+  msg.twist.twist.linear.x = odometry_integrator_.vx();
+  msg.twist.twist.linear.y = odometry_integrator_.vy();
+  msg.twist.twist.angular.z = odometry_integrator_.yawRate();
+  odometry_pub_->publish(msg);
+
+  if (odometry_publish_tf_) {
+    auto & tf_msg = odometry_tf_msg_;
+    tf_msg.header.stamp = stamp;
+    tf_msg.transform.translation.x = odometry_integrator_.x();
+    tf_msg.transform.translation.y = odometry_integrator_.y();
+    tf_msg.transform.rotation = orientation;
+    tf_broadcaster_->sendTransform(tf_msg);
+  }
+}
+
 void StandardRobotPpRos2Node::publishGroundRobotPosition(
   ReceiveGroundRobotPosition & ground_robot_position)
 {
+  if (!ground_robot_position_decimator_.tick()) {
+    return;
+  }
+
   pb_rm_interfaces::msg::GroundRobotPosition msg;
 
   msg.hero_position.x = ground_robot_position.data.hero_x;
@@ -554,6 +1813,14 @@ void StandardRobotPpRos2Node::publishGroundRobotPosition(
 
 void StandardRobotPpRos2Node::publishRfidStatus(ReceiveRfidStatus & rfid_status)
 {
+  if (!rfid_status_decimator_.tick()) {
+    return;
+  }
+
+  if (!rfid_status_change_.shouldPublish(rfid_status.data, ChangeDetector::Clock::now())) {
+    return;
+  }
+
   pb_rm_interfaces::msg::RfidStatus msg;
 
   msg.base_gain_point = rfid_status.data.base_gain_point;
@@ -592,6 +1859,10 @@ void StandardRobotPpRos2Node::publishRfidStatus(ReceiveRfidStatus & rfid_status)
 
 void StandardRobotPpRos2Node::publishRobotStatus(ReceiveRobotStatus & robot_status)
 {
+  if (!robot_status_decimator_.tick()) {
+    return;
+  }
+
   pb_rm_interfaces::msg::RobotStatus msg;
 
   msg.robot_id = robot_status.data.robot_id;
@@ -621,23 +1892,100 @@ void StandardRobotPpRos2Node::publishRobotStatus(ReceiveRobotStatus & robot_stat
 
 void StandardRobotPpRos2Node::publishJointState(ReceiveJointState & joint_state)
 {
-  sensor_msgs::msg::JointState msg;
+  if (mcu_clock_.isSynced()) {
+    attitude_history_->pushJoint(
+      mcu_clock_.toHostNs(joint_state.time_stamp), joint_state.data.pitch, joint_state.data.yaw);
+  }
 
-  msg.position.resize(2);
-  msg.name.resize(2);
-  msg.header.stamp = now();
+  const float feedback[2] = {joint_state.data.pitch, joint_state.data.yaw};
+  uint64_t packed;
+  std::memcpy(&packed, feedback, sizeof(packed));
+  gimbal_feedback_.store(packed, std::memory_order_relaxed);
 
-  msg.name[0] = "gimbal_pitch_joint";
-  msg.position[0] = joint_state.data.pitch;
+  // 使用同步后的下位机时间，关节状态与 TF 反映编码器实际采样的时刻，且两者时间戳一致
+  const rclcpp::Time stamp = hostStamp(joint_state.time_stamp);
 
-  msg.name[1] = "gimbal_yaw_joint";
-  msg.position[1] = joint_state.data.yaw;
+  // TF 以全速率广播，不受 gimbal_joint_state 降频影响
+  if (gimbal_tf_enable_) {
+    broadcastGimbalTf(joint_state, stamp);
+  }
+
+  if (!joint_state_decimator_.tick()) {
+    return;
+  }
 
+  auto & msg = joint_state_msg_;
+  msg.header.stamp = stamp;
+  msg.position[0] = joint_state.data.pitch;
+  msg.position[1] = joint_state.data.yaw;
   joint_state_pub_->publish(msg);
 }
 
+void StandardRobotPpRos2Node::robotDescriptionCallback(
+  const std_msgs::msg::String::SharedPtr msg)
+{
+  urdf::Model model;
+  if (!model.initString(msg->data)) {
+    RCLCPP_ERROR(get_logger(), "Failed to parse robot_description, gimbal TF disabled");
+    return;
+  }
+
+  auto joints = std::make_shared<GimbalJoints>();
+  const std::string names[2] = {gimbal_pitch_joint_, gimbal_yaw_joint_};
+  for (size_t i = 0; i < joints->size(); i++) {
+    auto & joint = (*joints)[i];
+    std::string error;
+    if (!loadGimbalJoint(
+          model, names[i], joint.parent_frame, joint.child_frame, joint.origin, joint.axis,
+          error)) {
+      RCLCPP_ERROR(get_logger(), "Invalid robot_description: %s", error.c_str());
+      return;
+    }
+  }
+
+  std::atomic_store(&gimbal_joints_, std::shared_ptr<const GimbalJoints>(joints));
+  RCLCPP_INFO(
+    get_logger(), "Broadcasting gimbal TF for %s and %s", gimbal_pitch_joint_.c_str(),
+    gimbal_yaw_joint_.c_str());
+}
+
+void StandardRobotPpRos2Node::broadcastGimbalTf(
+  const ReceiveJointState & joint_state, const rclcpp::Time & stamp)
+{
+  const auto joints = std::atomic_load(&gimbal_joints_);
+  if (!joints) {
+    RCLCPP_WARN_THROTTLE(
+      get_logger(), *get_clock(), 5000, "Waiting for robot_description to broadcast gimbal TF");
+    return;
+  }
+
+  const double positions[2] = {joint_state.data.pitch, joint_state.data.yaw};
+
+  for (size_t i = 0; i < joints->size(); i++) {
+    const auto & joint = (*joints)[i];
+    const tf2::Transform transform =
+      joint.origin *
+      tf2::Transform(tf2::Quaternion(joint.axis, positions[i]), tf2::Vector3(0, 0, 0));
+
+    auto & msg = gimbal_tf_msgs_[i];
+    msg.header.stamp = stamp;
+    msg.header.frame_id = joint.parent_frame;
+    msg.child_frame_id = joint.child_frame;
+    msg.transform = tf2::toMsg(transform);
+  }
+  tf_broadcaster_->sendTransform(gimbal_tf_msgs_);
+}
+
 void StandardRobotPpRos2Node::publishBuff(ReceiveBuff & buff)
 {
+  if (!buff_decimator_.tick()) {
+    return;
+  }
+
+  if (!buff_change_.shouldPublish(buff.data, ChangeDetector::Clock::now())) {
+    return;
+  }
+
   pb_rm_interfaces::msg::Buff msg;
   msg.recovery_buff = buff.data.recovery_buff;
   msg.cooling_buff = buff.data.cooling_buff;
@@ -655,6 +2003,8 @@ void StandardRobotPpRos2Node::sendData()
 {
   RCLCPP_INFO(get_logger(), "Start sendData!");
 
+  configureCurrentThread("sr_send", send_thread_config_);
+
   send_robot_cmd_data_.frame_header.sof = SOF_SEND;
   send_robot_cmd_data_.frame_header.id = ID_ROBOT_CMD;
   send_robot_cmd_data_.frame_header.len = sizeof(SendRobotCmdData) - 6;
@@ -664,14 +2014,36 @@ void StandardRobotPpRos2Node::sendData()
 
   int retry_count = 0;
 
-  while (rclcpp::ok()) {
+  while (isRunning()) {
     if (!is_usb_ok_) {
       RCLCPP_WARN(get_logger(), "send: usb is not ok! Retry count: %d", retry_count++);
-      std::this_thread::sleep_for(std::chrono::milliseconds(USB_NOT_OK_SLEEP_TIME));
+      sleepFor(std::chrono::milliseconds(USB_NOT_OK_SLEEP_TIME));
+      continue;
+    }
+
+    if (!is_active_) {
+      // 下位机在上位机未激活时也持续发送反馈
+      if (simulation_enable_) {
+        std::lock_guard<std::mutex> lock(port_mutex_);
+        simulateLink();
+      }
+      sleepFor(std::chrono::milliseconds(SEND_PERIOD));
       continue;
     }
 
     try {
+      {
+        std::lock_guard<std::mutex> lock(cmd_input_mutex_);
+        send_robot_cmd_data_.data = cmd_input_;
+      }
+      if (gimbal_fast_path_enable_) {
+        updateGimbalFromSetpointSlot();
+      }
+      if (aim_enable_) {
+        updateAimCommand();
+      }
+      updateFireCommand();
+
       // 整包数据校验
       // 添加数据段crc16校验
       crc16::append_CRC16_check_sum(
@@ -679,21 +2051,139 @@ void StandardRobotPpRos2Node::sendData()
 
       // 发送数据
       std::vector<uint8_t> send_data = toVector(send_robot_cmd_data_);
-      serial_driver_->port()->send(send_data);
+      std::lock_guard<std::mutex> lock(port_mutex_);
+      if (simulation_enable_) {
+        simulateLink();
+      } else {
+        serial_driver_->port()->send(send_data);
+      }
     } catch (const std::exception & ex) {
       RCLCPP_ERROR(get_logger(), "Error sending data: %s", ex.what());
       is_usb_ok_ = false;
     }
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    sleepFor(sendSleepDuration());
+  }
+}
+
+void StandardRobotPpRos2Node::simulateLink()
+{
+  // 仿真推进到当前时刻后，像串口收到数据一样交给接收线程
+  const auto steady_now = std::chrono::steady_clock::now();
+  simulator_.setCommand(send_robot_cmd_data_);
+  simulator_.step(std::chrono::duration<double>(steady_now - simulation_time_).count());
+  simulation_time_ = steady_now;
+
+  std::vector<uint8_t> frames = toVector(simulator_.jointState());
+  const std::vector<uint8_t> imu_frame = toVector(simulator_.imuData());
+  frames.insert(frames.end(), imu_frame.begin(), imu_frame.end());
+  onReceive(frames, frames.size());
+}
+
+void StandardRobotPpRos2Node::updateGimbalFromSetpointSlot()
+{
+  // 云台管理节点不在本进程或已销毁时，每秒重新查找一次
+  const auto steady_now = std::chrono::steady_clock::now();
+  if (
+    !gimbal_setpoint_slot_ &&
+    steady_now - gimbal_setpoint_lookup_time_ >= std::chrono::seconds(1)) {
+    gimbal_setpoint_lookup_time_ = steady_now;
+    gimbal_setpoint_slot_ = ProcessRegistry<GimbalSetpointSlot>::find(gimbal_setpoint_key_);
+    if (gimbal_setpoint_slot_) {
+      RCLCPP_INFO(
+        get_logger(), "Using in-process gimbal setpoints from %s", gimbal_setpoint_key_.c_str());
+    }
+  }
+
+  GimbalSetpoint setpoint;
+  const bool fresh = gimbal_setpoint_slot_ && gimbal_setpoint_slot_->readLatest(setpoint) &&
+                     now().nanoseconds() - setpoint.stamp_ns <= gimbal_setpoint_timeout_.count();
+  if (!fresh) {
+    // 长时间没有新设定值时释放旧的通道，以便云台管理节点重启后重新查找，本帧使用话题指令
+    gimbal_setpoint_slot_.reset();
+    return;
+  }
+
+  send_robot_cmd_data_.data.gimbal.pitch = setpoint.pitch;
+  send_robot_cmd_data_.data.gimbal.yaw = setpoint.yaw;
+}
+
+void StandardRobotPpRos2Node::updateAimCommand()
+{
+  TargetState target;
+  {
+    std::lock_guard<std::mutex> lock(target_mutex_);
+    target = target_state_;
+  }
+  const int64_t now_ns = now().nanoseconds();
+  aim_solution_valid_ = target.tracking && now_ns - target.stamp_ns <= aim_target_timeout_.count();
+  if (!aim_solution_valid_) {
+    // 本帧的云台角已从暂存指令重新填写，不再保持上一次的瞄准角
+    aim_solution_ = AimSolution();
+    return;
+  }
+
+  // 外推到指令到达下位机的时刻：观测至今的时间 + 名义链路延迟 + 额外执行延迟
+  const int64_t lead_ns =
+    now_ns - target.stamp_ns + mcu_clock_.nominalLatencyNs() + aim_extra_delay_.count();
+  aim_solution_ = target_predictor_.solve(target, lead_ns * 1e-9);
+  send_robot_cmd_data_.data.gimbal.pitch = aim_solution_.pitch;
+  send_robot_cmd_data_.data.gimbal.yaw = aim_solution_.yaw;
+}
+
+void StandardRobotPpRos2Node::updateFireCommand()
+{
+  // 预测瞄准误差：本帧的瞄准角与当前云台反馈之差，没有自瞄解算时无法预测
+  double aim_error = -1.0;
+  if (aim_enable_ && aim_solution_valid_) {
+    const uint64_t packed = gimbal_feedback_.load(std::memory_order_relaxed);
+    float feedback[2];
+    std::memcpy(feedback, &packed, sizeof(feedback));
+    const double pitch_error = aim_solution_.pitch - feedback[0];
+    const double yaw_error = std::remainder(aim_solution_.yaw - feedback[1], 2 * M_PI);
+    aim_error = std::hypot(pitch_error, yaw_error * std::cos(feedback[0]));
+  }
+
+  const int64_t arrival_ns = now().nanoseconds() + fireLatencyNs();
+  const int64_t tolerance_ns = FIRE_TIME_TOLERANCE * 1000LL;
+  // 射击字段只由本函数填写：调度期间与开火帧之后 fire 为 0，只在选中的帧置位，
+  // 没有调度中的请求时为 cmd_shoot 的直接指令
+  std::lock_guard<std::mutex> lock(fire_mutex_);
+  const auto action = fire_scheduler_.nextFrame(arrival_ns, tolerance_ns, aim_error);
+  send_robot_cmd_data_.data.shoot.fric_on = fire_scheduler_.fricOn();
+  send_robot_cmd_data_.data.shoot.fire = fire_scheduler_.fireValue(action);
+}
+
+int64_t StandardRobotPpRos2Node::fireLatencyNs() const
+{
+  // 协议中没有下行方向的测量，名义延迟是接收方向的估计（配置的基础延迟加接收排队）；
+  // 下行实际延迟加拨弹执行时间与它的差值由 fire_scheduler.extra_delay_ms 标定
+  return mcu_clock_.nominalLatencyNs() + fire_extra_delay_.count();
+}
+
+std::chrono::nanoseconds StandardRobotPpRos2Node::sendSleepDuration()
+{
+  const std::chrono::nanoseconds period = std::chrono::milliseconds(SEND_PERIOD);
+  int64_t wakeup_ns;
+  {
+    std::lock_guard<std::mutex> lock(fire_mutex_);
+    wakeup_ns = fire_scheduler_.wakeupNs(fireLatencyNs());
+  }
+  if (wakeup_ns == FireScheduler::NO_WAKEUP) {
+    return period;
   }
+
+  // 定时开火请求在发送周期内到期时提前唤醒，使开火帧恰好在目标时刻到达下位机
+  const std::chrono::nanoseconds until_wakeup(wakeup_ns - now().nanoseconds());
+  return std::max(std::chrono::nanoseconds(0), std::min(period, until_wakeup));
 }
 
 void StandardRobotPpRos2Node::cmdVelCallback(const geometry_msgs::msg::Twist::SharedPtr msg)
 {
-  send_robot_cmd_data_.data.speed_vector.vx = msg->linear.x;
-  send_robot_cmd_data_.data.speed_vector.vy = msg->linear.y;
-  send_robot_cmd_data_.data.speed_vector.wz = msg->angular.z;
+  std::lock_guard<std::mutex> lock(cmd_input_mutex_);
+  cmd_input_.speed_vector.vx = msg->linear.x;
+  cmd_input_.speed_vector.vy = msg->linear.y;
+  cmd_input_.speed_vector.wz = msg->angular.z;
 }
 
 void StandardRobotPpRos2Node::cmdGimbalJointCallback(
@@ -705,23 +2195,111 @@ void StandardRobotPpRos2Node::cmdGimbalJointCallback(
     return;
   }
 
+  // 快速通道生效时同样保存，设定值过期后发送线程回退到最新的话题指令
+  std::lock_guard<std::mutex> lock(cmd_input_mutex_);
   for (size_t i = 0; i < msg->name.size(); ++i) {
     if (msg->name[i] == "gimbal_pitch_joint") {
-      send_robot_cmd_data_.data.gimbal.pitch = msg->position[i];
+      cmd_input_.gimbal.pitch = msg->position[i];
     } else if (msg->name[i] == "gimbal_yaw_joint") {
-      send_robot_cmd_data_.data.gimbal.yaw = msg->position[i];
+      cmd_input_.gimbal.yaw = msg->position[i];
     }
   }
 }
 
 void StandardRobotPpRos2Node::cmdTrakcingCallback(const auto_aim_interfaces::msg::Target::SharedPtr msg)
 {
-  send_robot_cmd_data_.data.tracking.tracking = msg->tracking;
+  {
+    std::lock_guard<std::mutex> lock(cmd_input_mutex_);
+    cmd_input_.tracking.tracking = msg->tracking;
+  }
+  if (!aim_enable_) {
+    return;
+  }
+
+  TargetState target;
+  const int64_t stamp_ns = rclcpp::Time(msg->header.stamp).nanoseconds();
+  target.stamp_ns = stamp_ns > 0 ? stamp_ns : now().nanoseconds();
+  target.tracking = msg->tracking;
+  target.armors_num = msg->armors_num;
+  target.x = msg->position.x;
+  target.y = msg->position.y;
+  target.z = msg->position.z;
+  target.vx = msg->velocity.x;
+  target.vy = msg->velocity.y;
+  target.vz = msg->velocity.z;
+  target.yaw = msg->yaw;
+  target.v_yaw = msg->v_yaw;
+  target.radius_1 = msg->radius_1;
+  target.radius_2 = msg->radius_2;
+  target.dz = msg->dz;
+
+  // frame_id 为空时认为目标已位于解算坐标系中
+  const std::string & frame_id = msg->header.frame_id;
+  if (
+    !frame_id.empty() && frame_id != aim_frame_id_ &&
+    !transformTargetToAimFrame(frame_id, msg->header.stamp, target)) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(target_mutex_);
+  target_state_ = target;
+}
+
+bool StandardRobotPpRos2Node::transformTargetToAimFrame(
+  const std::string & frame_id, const builtin_interfaces::msg::Time & stamp,
+  TargetState & target)
+{
+  geometry_msgs::msg::TransformStamped transform_msg;
+  try {
+    transform_msg = tf_buffer_->lookupTransform(aim_frame_id_, frame_id, rclcpp::Time(stamp));
+  } catch (const tf2::TransformException & ex) {
+    RCLCPP_WARN_THROTTLE(
+      get_logger(), *get_clock(), 1000, "Target ignored, no transform %s -> %s: %s",
+      frame_id.c_str(), aim_frame_id_.c_str(), ex.what());
+    return false;
+  }
+
+  // 取观测时刻的变换：位置做完整变换，速度只旋转，装甲板朝向加上绕 z 轴的转角
+  tf2::Transform transform;
+  tf2::fromMsg(transform_msg.transform, transform);
+  const tf2::Vector3 position = transform * tf2::Vector3(target.x, target.y, target.z);
+  const tf2::Vector3 velocity =
+    transform.getBasis() * tf2::Vector3(target.vx, target.vy, target.vz);
+  double roll, pitch, yaw;
+  transform.getBasis().getRPY(roll, pitch, yaw);
+
+  target.x = position.x();
+  target.y = position.y();
+  target.z = position.z();
+  target.vx = velocity.x();
+  target.vy = velocity.y();
+  target.vz = velocity.z();
+  target.yaw += yaw;
+  return true;
+}
+void StandardRobotPpRos2Node::cmdShootAtCallback(const builtin_interfaces::msg::Time::SharedPtr msg)
+{
+  std::lock_guard<std::mutex> lock(fire_mutex_);
+  fire_scheduler_.scheduleAt(rclcpp::Time(*msg).nanoseconds());
+}
+
+void StandardRobotPpRos2Node::cmdShootWhenAimedCallback(
+  const example_interfaces::msg::Float64::SharedPtr msg)
+{
+  if (!aim_enable_) {
+    RCLCPP_WARN_THROTTLE(
+      get_logger(), *get_clock(), 1000, "cmd_shoot_when_aimed requires aim.enable, ignored");
+    return;
+  }
+  const int64_t expire_ns = now().nanoseconds() + fire_aim_timeout_.count();
+  std::lock_guard<std::mutex> lock(fire_mutex_);
+  fire_scheduler_.scheduleWhenAimed(msg->data, expire_ns);
 }
+
 void StandardRobotPpRos2Node::cmdShootCallback(const example_interfaces::msg::UInt8::SharedPtr msg)
 {
-  send_robot_cmd_data_.data.shoot.fric_on = true;
-  send_robot_cmd_data_.data.shoot.fire = msg->data;
+  std::lock_guard<std::mutex> lock(fire_mutex_);
+  fire_scheduler_.setManualFire(msg->data);
 }
 
 }  // namespace standard_robot_pp_ros2
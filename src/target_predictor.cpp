@@ -0,0 +1,87 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "standard_robot_pp_ros2/target_predictor.hpp"
+
+#include <cmath>
+
+namespace standard_robot_pp_ros2
+{
+
+namespace
+{
+// 飞行时间与预测位置相互依赖，迭代数次即可收敛到毫米级
+constexpr int FLIGHT_TIME_ITERATIONS = 3;
+}  // namespace
+
+AimSolution TargetPredictor::solve(const TargetState & target, double lead_time) const
+{
+  const int armors_num = target.armors_num > 0 ? target.armors_num : 1;
+  double flight_time = 0.0;
+  double aim_x = target.x;
+  double aim_y = target.y;
+  double aim_z = target.z;
+  double elevation = 0.0;
+
+  for (int iteration = 0; iteration < FLIGHT_TIME_ITERATIONS; ++iteration) {
+    const double dt = lead_time + flight_time;
+    const double center_x = target.x + target.vx * dt;
+    const double center_y = target.y + target.vy * dt;
+    const double center_z = target.z + target.vz * dt;
+    const double center_yaw = target.yaw + target.v_yaw * dt;
+
+    // 选择朝向最接近正对自身的装甲板，即装甲板朝向与视线方位角之差最小
+    const double azimuth = std::atan2(center_y, center_x);
+    double min_diff = M_PI * 2;
+    for (int i = 0; i < armors_num; ++i) {
+      const double armor_yaw = center_yaw + i * 2 * M_PI / armors_num;
+      const double diff = std::abs(std::remainder(armor_yaw - azimuth, 2 * M_PI));
+      if (diff >= min_diff) {
+        continue;
+      }
+      min_diff = diff;
+      // 四块装甲板时两组交替使用 radius_1/radius_2，第二组高度偏移 dz
+      const bool second_pair = armors_num == 4 && i % 2 == 1;
+      const double radius = second_pair ? target.radius_2 : target.radius_1;
+      aim_x = center_x - radius * std::cos(armor_yaw);
+      aim_y = center_y - radius * std::sin(armor_yaw);
+      aim_z = center_z + (second_pair ? target.dz : 0.0);
+    }
+
+    solveBallistic(std::hypot(aim_x, aim_y), aim_z, elevation, flight_time);
+  }
+
+  AimSolution solution;
+  solution.pitch = -elevation;
+  solution.yaw = std::atan2(aim_y, aim_x);
+  solution.flight_time = flight_time;
+  return solution;
+}
+
+void TargetPredictor::solveBallistic(
+  double distance, double height, double & elevation, double & flight_time) const
+{
+  // 无空气阻力的抛体：tan(theta) = (v^2 - sqrt(v^4 - g (g d^2 + 2 h v^2))) / (g d)，取低弹道
+  const double v2 = bullet_speed_ * bullet_speed_;
+  const double discriminant =
+    v2 * v2 - gravity_ * (gravity_ * distance * distance + 2 * height * v2);
+  if (distance <= 0.0 || discriminant < 0.0) {
+    elevation = std::atan2(height, distance);
+    flight_time = std::hypot(distance, height) / bullet_speed_;
+    return;
+  }
+  elevation = std::atan((v2 - std::sqrt(discriminant)) / (gravity_ * distance));
+  flight_time = distance / (bullet_speed_ * std::cos(elevation));
+}
+
+}  // namespace standard_robot_pp_ros2
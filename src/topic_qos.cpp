@@ -0,0 +1,57 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "standard_robot_pp_ros2/topic_qos.hpp"
+
+namespace standard_robot_pp_ros2
+{
+
+bool isValidTopicQos(const TopicQos & config, std::string & error)
+{
+  if (config.reliability != "reliable" && config.reliability != "best_effort") {
+    error = "reliability must be one of: reliable, best_effort";
+    return false;
+  }
+  if (config.durability != "volatile" && config.durability != "transient_local") {
+    error = "durability must be one of: volatile, transient_local";
+    return false;
+  }
+  if (config.depth < 1) {
+    error = "depth must be positive";
+    return false;
+  }
+  if (config.decimation < 1) {
+    error = "decimation must be positive";
+    return false;
+  }
+  return true;
+}
+
+rclcpp::QoS toQos(const TopicQos & config)
+{
+  rclcpp::QoS qos(static_cast<size_t>(config.depth));
+  if (config.reliability == "best_effort") {
+    qos.best_effort();
+  } else {
+    qos.reliable();
+  }
+  if (config.durability == "transient_local") {
+    qos.transient_local();
+  } else {
+    qos.durability_volatile();
+  }
+  return qos;
+}
+
+}  // namespace standard_robot_pp_ros2
@@ -0,0 +1,78 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "standard_robot_pp_ros2/trajectory_generator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace standard_robot_pp_ros2
+{
+
+namespace
+{
+// 位置环只使用一半的加速度上限作为减速能力，为加加速度限制带来的滞后留出余量，避免超调
+constexpr double POSITION_DECEL_RATIO = 0.5;
+// 位置环增益与速度环增益之比，保证级联后无明显超调
+constexpr double POSITION_GAIN_RATIO = 1.0 / 3.0;
+
+double clamp(double value, double limit) { return std::max(-limit, std::min(value, limit)); }
+
+/// 误差较小时为线性控制，较大时按恒定减速度 second_order_limit 刚好在目标处停下
+double sqrtController(double error, double gain, double second_order_limit)
+{
+  const double linear_dist = second_order_limit / (gain * gain);
+  if (error > linear_dist) {
+    return std::sqrt(2.0 * second_order_limit * (error - linear_dist / 2.0));
+  }
+  if (error < -linear_dist) {
+    return -std::sqrt(2.0 * second_order_limit * (-error - linear_dist / 2.0));
+  }
+  return error * gain;
+}
+}  // namespace
+
+void JerkLimitedTrajectory::reset(double position, double velocity)
+{
+  position_ = position;
+  velocity_ = clamp(velocity, limits_.max_velocity);
+  acceleration_ = 0.0;
+}
+
+double JerkLimitedTrajectory::update(double target, double dt)
+{
+  if (dt <= 0.0) {
+    return position_;
+  }
+
+  const double velocity_gain = limits_.max_jerk / limits_.max_acceleration;
+  const double position_gain = velocity_gain * POSITION_GAIN_RATIO;
+
+  const double desired_velocity = clamp(
+    sqrtController(
+      target - position_, position_gain, limits_.max_acceleration * POSITION_DECEL_RATIO),
+    limits_.max_velocity);
+  const double desired_acceleration = clamp(
+    sqrtController(desired_velocity - velocity_, velocity_gain, limits_.max_jerk),
+    limits_.max_acceleration);
+
+  acceleration_ += clamp(desired_acceleration - acceleration_, limits_.max_jerk * dt);
+
+  const double next_velocity = clamp(velocity_ + acceleration_ * dt, limits_.max_velocity);
+  position_ += 0.5 * (velocity_ + next_velocity) * dt;
+  velocity_ = next_velocity;
+  return position_;
+}
+
+}  // namespace standard_robot_pp_ros2
@@ -0,0 +1,157 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "standard_robot_pp_ros2/fire_scheduler.hpp"
+
+using standard_robot_pp_ros2::FireScheduler;
+using Action = FireScheduler::Action;
+
+namespace
+{
+const int64_t kMs = 1000000;
+const int64_t kTolerance = 200000;  // 与节点中的 FIRE_TIME_TOLERANCE 相同 (ns)
+const double kNoAim = -1.0;
+}  // namespace
+
+TEST(FireScheduler, IdleLeavesFireAlone)
+{
+  FireScheduler scheduler;
+  EXPECT_FALSE(scheduler.pending());
+  EXPECT_EQ(scheduler.nextFrame(0, kTolerance, kNoAim), Action::NONE);
+  EXPECT_EQ(scheduler.wakeupNs(0), FireScheduler::NO_WAKEUP);
+}
+
+TEST(FireScheduler, PastFireTimeFiresImmediately)
+{
+  FireScheduler scheduler;
+  scheduler.scheduleAt(100 * kMs);
+  EXPECT_EQ(scheduler.nextFrame(150 * kMs, kTolerance, kNoAim), Action::FIRE);
+  EXPECT_FALSE(scheduler.pending());
+}
+
+TEST(FireScheduler, FiresOnlyWithinToleranceWindow)
+{
+  FireScheduler scheduler;
+  const int64_t fire_ns = 100 * kMs;
+  scheduler.scheduleAt(fire_ns);
+
+  EXPECT_EQ(scheduler.nextFrame(fire_ns - 2 * kMs, kTolerance, kNoAim), Action::HOLD);
+  EXPECT_EQ(scheduler.nextFrame(fire_ns - kTolerance - 1, kTolerance, kNoAim), Action::HOLD);
+  EXPECT_TRUE(scheduler.pending());
+  EXPECT_EQ(scheduler.nextFrame(fire_ns - kTolerance, kTolerance, kNoAim), Action::FIRE);
+}
+
+TEST(FireScheduler, WakeupAlignsArrivalWithFireTime)
+{
+  FireScheduler scheduler;
+  scheduler.scheduleAt(100 * kMs);
+  EXPECT_EQ(scheduler.wakeupNs(3 * kMs), 97 * kMs);
+
+  // 瞄准请求没有固定时刻，不提前唤醒
+  scheduler.scheduleWhenAimed(0.01, 200 * kMs);
+  EXPECT_EQ(scheduler.wakeupNs(3 * kMs), FireScheduler::NO_WAKEUP);
+}
+
+TEST(FireScheduler, WhenAimedFiresOnFirstAimedFrame)
+{
+  FireScheduler scheduler;
+  scheduler.scheduleWhenAimed(0.01, 100 * kMs);
+
+  EXPECT_EQ(scheduler.nextFrame(10 * kMs, kTolerance, kNoAim), Action::HOLD);
+  EXPECT_EQ(scheduler.nextFrame(11 * kMs, kTolerance, 0.05), Action::HOLD);
+  EXPECT_EQ(scheduler.nextFrame(12 * kMs, kTolerance, 0.01), Action::FIRE);
+  EXPECT_FALSE(scheduler.pending());
+}
+
+TEST(FireScheduler, WhenAimedExpires)
+{
+  FireScheduler scheduler;
+  scheduler.scheduleWhenAimed(0.01, 100 * kMs);
+
+  EXPECT_EQ(scheduler.nextFrame(100 * kMs, kTolerance, 0.05), Action::HOLD);
+  EXPECT_TRUE(scheduler.pending());
+  // 过期后即使已经瞄准也不再开火
+  EXPECT_EQ(scheduler.nextFrame(100 * kMs + 1, kTolerance, 0.0), Action::HOLD);
+  EXPECT_FALSE(scheduler.pending());
+  EXPECT_EQ(scheduler.nextFrame(101 * kMs, kTolerance, 0.0), Action::NONE);
+}
+
+TEST(FireScheduler, FireIsHeldForExactlyOneFrame)
+{
+  FireScheduler scheduler;
+  scheduler.scheduleAt(0);
+
+  EXPECT_EQ(scheduler.nextFrame(1 * kMs, kTolerance, kNoAim), Action::FIRE);
+  // 开火帧之后的一帧清零，再之后交还 cmd_shoot
+  EXPECT_EQ(scheduler.nextFrame(2 * kMs, kTolerance, kNoAim), Action::HOLD);
+  EXPECT_EQ(scheduler.nextFrame(3 * kMs, kTolerance, kNoAim), Action::NONE);
+}
+
+TEST(FireScheduler, BackToBackRequestsFireOnSeparateFrames)
+{
+  FireScheduler scheduler;
+  scheduler.scheduleAt(0);
+  EXPECT_EQ(scheduler.nextFrame(1 * kMs, kTolerance, kNoAim), Action::FIRE);
+
+  // 开火帧之后立即到来的请求顺延一帧，两次开火之间至少有一帧 fire 为 0
+  scheduler.scheduleAt(0);
+  EXPECT_EQ(scheduler.nextFrame(2 * kMs, kTolerance, kNoAim), Action::HOLD);
+  EXPECT_TRUE(scheduler.pending());
+  EXPECT_EQ(scheduler.nextFrame(3 * kMs, kTolerance, kNoAim), Action::FIRE);
+  EXPECT_EQ(scheduler.nextFrame(4 * kMs, kTolerance, kNoAim), Action::HOLD);
+}
+
+TEST(FireScheduler, NewRequestReplacesPendingOne)
+{
+  FireScheduler scheduler;
+  scheduler.scheduleAt(0);
+  scheduler.scheduleWhenAimed(0.01, 100 * kMs);
+  EXPECT_EQ(scheduler.nextFrame(1 * kMs, kTolerance, kNoAim), Action::HOLD);
+
+  scheduler.cancel();
+  EXPECT_EQ(scheduler.nextFrame(2 * kMs, kTolerance, 0.0), Action::NONE);
+}
+
+TEST(FireScheduler, ManualFireAppliesOnlyWithoutPendingRequest)
+{
+  FireScheduler scheduler;
+  scheduler.setManualFire(1);
+  EXPECT_EQ(scheduler.fireValue(scheduler.nextFrame(1 * kMs, kTolerance, kNoAim)), 1);
+
+  // 调度中的请求覆盖 cmd_shoot，请求结束后恢复直接指令
+  scheduler.scheduleAt(10 * kMs);
+  EXPECT_EQ(scheduler.fireValue(scheduler.nextFrame(2 * kMs, kTolerance, kNoAim)), 0);
+  EXPECT_EQ(scheduler.fireValue(scheduler.nextFrame(10 * kMs, kTolerance, kNoAim)), 1);
+  EXPECT_EQ(scheduler.fireValue(scheduler.nextFrame(11 * kMs, kTolerance, kNoAim)), 0);
+  EXPECT_EQ(scheduler.fireValue(scheduler.nextFrame(12 * kMs, kTolerance, kNoAim)), 1);
+
+  scheduler.setManualFire(0);
+  EXPECT_EQ(scheduler.fireValue(scheduler.nextFrame(13 * kMs, kTolerance, kNoAim)), 0);
+}
+
+TEST(FireScheduler, FrictionStaysOnOnceRequested)
+{
+  FireScheduler scheduler;
+  EXPECT_FALSE(scheduler.fricOn());
+
+  scheduler.scheduleWhenAimed(0.01, 10 * kMs);
+  EXPECT_TRUE(scheduler.fricOn());
+  EXPECT_EQ(scheduler.nextFrame(11 * kMs, kTolerance, kNoAim), Action::HOLD);
+  EXPECT_FALSE(scheduler.pending());
+  EXPECT_TRUE(scheduler.fricOn());
+}
@@ -0,0 +1,147 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+#include "standard_robot_pp_ros2/gimbal_simulator.hpp"
+
+using standard_robot_pp_ros2::GimbalSimulator;
+using standard_robot_pp_ros2::SendRobotCmdData;
+
+namespace
+{
+const double kStep = 0.001;  // (s)
+
+GimbalSimulator::AxisConfig unlimitedAxis()
+{
+  GimbalSimulator::AxisConfig config;
+  config.position_limited = false;
+  return config;
+}
+
+SendRobotCmdData command(double pitch, double yaw)
+{
+  SendRobotCmdData cmd{};
+  cmd.data.gimbal.pitch = static_cast<float>(pitch);
+  cmd.data.gimbal.yaw = static_cast<float>(yaw);
+  return cmd;
+}
+}  // namespace
+
+TEST(GimbalSimulator, StepSettlesWithinSecondOrderBound)
+{
+  GimbalSimulator sim;
+  const GimbalSimulator::AxisConfig pitch;
+  sim.configure(pitch, unlimitedAxis());
+  sim.reset();
+  sim.setCommand(command(0.5, 0.0));
+
+  // 2% 调节时间，欠阻尼二阶系统约为 4 / (zeta * wn)
+  const double band = 0.02 * 0.5;
+  double settling_time = 0.0;
+  for (int i = 1; i <= 1000; i++) {
+    sim.step(kStep);
+    if (std::abs(sim.pitch() - 0.5) > band) {
+      settling_time = i * kStep;
+    }
+  }
+  EXPECT_GT(settling_time, 0.0);
+  EXPECT_LT(settling_time, 4.0 / (pitch.damping * pitch.natural_frequency));
+  EXPECT_NEAR(sim.pitch(), 0.5, 1e-3);
+}
+
+TEST(GimbalSimulator, SineTrackingErrorMatchesClosedLoopResponse)
+{
+  GimbalSimulator sim;
+  const GimbalSimulator::AxisConfig yaw = unlimitedAxis();
+  sim.configure(GimbalSimulator::AxisConfig(), yaw);
+  sim.reset();
+
+  const double amplitude = 0.2;
+  const double omega = 2 * M_PI;  // 1 Hz，远低于速度与加速度限制
+  double max_error = 0.0;
+  for (int i = 1; i <= 3000; i++) {
+    const double t = i * kStep;
+    const SendRobotCmdData cmd = command(0.0, amplitude * std::sin(omega * t));
+    sim.setCommand(cmd);
+    sim.step(kStep);
+    // 跳过前 1 s 的过渡过程
+    if (t > 1.0) {
+      max_error = std::max(max_error, std::abs(sim.yaw() - cmd.data.gimbal.yaw));
+    }
+  }
+
+  // 稳态误差幅值为 |1 - G(jw)| * A，G 为闭环二阶传递函数
+  const double wn = yaw.natural_frequency;
+  const std::complex<double> jw(0.0, omega);
+  const std::complex<double> g = wn * wn / (jw * jw + 2.0 * yaw.damping * wn * jw + wn * wn);
+  EXPECT_NEAR(max_error, std::abs(1.0 - g) * amplitude, 0.005);
+}
+
+TEST(GimbalSimulator, VelocityIsLimited)
+{
+  GimbalSimulator::AxisConfig yaw = unlimitedAxis();
+  yaw.max_velocity = 2.0;
+  GimbalSimulator sim;
+  sim.configure(GimbalSimulator::AxisConfig(), yaw);
+  sim.reset();
+  sim.setCommand(command(0.0, 3.0));
+
+  double last = sim.yaw();
+  for (int i = 0; i < 3000; i++) {
+    sim.step(kStep);
+    EXPECT_LE(std::abs(sim.yaw() - last) / kStep, yaw.max_velocity + 1e-9);
+    last = sim.yaw();
+  }
+  EXPECT_NEAR(sim.yaw(), 3.0, 1e-3);
+}
+
+TEST(GimbalSimulator, LimitedAxisStopsAtMechanicalLimit)
+{
+  GimbalSimulator::AxisConfig pitch;
+  pitch.min_position = -0.6;
+  pitch.max_position = 0.6;
+  GimbalSimulator sim;
+  sim.configure(pitch, unlimitedAxis());
+  sim.reset();
+  sim.setCommand(command(2.0, 10.0));
+  sim.step(3.0);
+
+  EXPECT_DOUBLE_EQ(sim.pitch(), 0.6);
+  // 不限位的轴越过 2*pi 继续转动，IMU 帧中的 yaw 折回 [-pi, pi]
+  EXPECT_NEAR(sim.yaw(), 10.0, 1e-3);
+  EXPECT_NEAR(sim.imuData().data.yaw, std::remainder(sim.yaw(), 2 * M_PI), 1e-5);
+}
+
+TEST(GimbalSimulator, JointStateIsQuantizedToEncoderResolution)
+{
+  GimbalSimulator::AxisConfig pitch;
+  pitch.encoder_resolution = 0.01;
+  GimbalSimulator sim;
+  sim.configure(pitch, unlimitedAxis());
+  sim.reset();
+  sim.setCommand(command(0.1234, 0.0));
+
+  for (int i = 0; i < 300; i++) {
+    sim.step(kStep);
+    const double encoder = sim.jointState().data.pitch;
+    const double counts = encoder / pitch.encoder_resolution;
+    EXPECT_NEAR(counts, std::round(counts), 1e-4);
+    EXPECT_LE(std::abs(encoder - sim.pitch()), 0.5 * pitch.encoder_resolution + 1e-6);
+  }
+}
@@ -0,0 +1,163 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <sys/prctl.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp_lifecycle/lifecycle_node.hpp"
+#include "sensor_msgs/msg/joint_state.hpp"
+#include "standard_robot_pp_ros2/gimbal_manager.hpp"
+
+// 替换全局 operator new，统计计数开启期间指定线程上的分配次数
+// C 代码中的 malloc（rcl、rmw 的默认分配器）不经过这里，只统计 C++ 侧的分配
+namespace
+{
+std::atomic<bool> g_counting{false};
+std::atomic<size_t> g_control_thread_allocations{0};
+thread_local bool t_counting = false;
+thread_local size_t t_allocations = 0;
+
+// 与 GimbalManagerNode::controlLoop 中设置的线程名一致
+const char kControlThreadName[] = "gimbal_ctrl";
+
+bool onControlThread()
+{
+  char name[16] = {};
+  prctl(PR_GET_NAME, name, 0, 0, 0);
+  return std::strcmp(name, kControlThreadName) == 0;
+}
+
+void countAllocation()
+{
+  if (t_counting) {
+    t_allocations++;
+  }
+  if (g_counting.load(std::memory_order_relaxed) && onControlThread()) {
+    g_control_thread_allocations++;
+  }
+}
+}  // namespace
+
+void * operator new(std::size_t size)
+{
+  countAllocation();
+  void * ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void * ptr) noexcept { std::free(ptr); }
+
+void operator delete(void * ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace
+{
+// 默认 NodeOptions 不开启进程内通信，与 launch 中组合运行的配置一致
+class JointStateAllocationTest : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase() { rclcpp::init(0, nullptr); }
+
+  static void TearDownTestCase() { rclcpp::shutdown(); }
+};
+
+void spinFor(rclcpp::Executor & executor, std::chrono::nanoseconds duration)
+{
+  const auto deadline = std::chrono::steady_clock::now() + duration;
+  while (std::chrono::steady_clock::now() < deadline) {
+    executor.spin_some(std::chrono::milliseconds(10));
+  }
+}
+}  // namespace
+
+TEST_F(JointStateAllocationTest, GimbalControlLoopDoesNotAllocate)
+{
+  rclcpp::NodeOptions options;
+  options.parameter_overrides({{"trajectory.enable", true}});
+  auto gimbal = std::make_shared<standard_robot_pp_ros2::GimbalManagerNode>(options);
+
+  auto probe = std::make_shared<rclcpp::Node>("joint_state_allocation_probe");
+  size_t received = 0;
+  auto sub = probe->create_subscription<sensor_msgs::msg::JointState>(
+    "cmd_gimbal_joint", 10,
+    [&received](sensor_msgs::msg::JointState::SharedPtr) { received++; });
+  auto cmd_pub = probe->create_publisher<sensor_msgs::msg::JointState>("cmd_gimbal_axes", 10);
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(gimbal);
+  executor.add_node(probe);
+
+  // 俯仰走位置命令（经过轨迹生成），偏航走速度命令，覆盖控制循环中的主要分支
+  sensor_msgs::msg::JointState cmd;
+  cmd.position = {0.3, std::numeric_limits<double>::quiet_NaN()};
+  cmd.velocity = {std::numeric_limits<double>::quiet_NaN(), 1.0};
+  cmd_pub->publish(cmd);
+
+  // 预热期间中间件建立匹配并填满历史缓存，循环统计也至少发布过一次
+  spinFor(executor, std::chrono::milliseconds(2500));
+  received = 0;
+
+  g_control_thread_allocations = 0;
+  g_counting = true;
+  spinFor(executor, std::chrono::milliseconds(2500));
+  g_counting = false;
+
+  EXPECT_GT(received, 0u);
+  EXPECT_EQ(g_control_thread_allocations.load(), 0u);
+}
+
+TEST_F(JointStateAllocationTest, LifecyclePublisherReusesPreallocatedMessage)
+{
+  // 与串口节点相同的发布方式：激活的生命周期发布者按引用发布预分配的消息
+  auto node = std::make_shared<rclcpp_lifecycle::LifecycleNode>("joint_state_allocation_serial");
+  auto pub = node->create_publisher<sensor_msgs::msg::JointState>("serial/gimbal_joint_state", 10);
+  pub->on_activate();
+
+  sensor_msgs::msg::JointState msg;
+  msg.name = {"gimbal_pitch_joint", "gimbal_yaw_joint"};
+  msg.position.resize(2);
+
+  auto publishOnce = [&](int i) {
+    msg.header.stamp = node->now();
+    msg.position[0] = 0.001 * i;
+    msg.position[1] = -0.001 * i;
+    pub->publish(msg);
+  };
+
+  for (int i = 0; i < 100; i++) {
+    publishOnce(i);
+  }
+
+  t_allocations = 0;
+  t_counting = true;
+  for (int i = 0; i < 1000; i++) {
+    publishOnce(i);
+  }
+  t_counting = false;
+
+  EXPECT_EQ(t_allocations, 0u);
+}
@@ -0,0 +1,113 @@
+// Copyright 2025 SMBU-PolarBear-Robotics-Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "standard_robot_pp_ros2/timed_join_thread.hpp"
+
+using standard_robot_pp_ros2::TimedJoinThread;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+// 调度抖动余量
+const auto kSlack = std::chrono::milliseconds(50);
+
+void waitUntilFinished(const TimedJoinThread & thread)
+{
+  while (!thread.finished()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+}  // namespace
+
+TEST(TimedJoinThread, JoinsThreadThatStops)
+{
+  std::atomic<bool> stop{false};
+  TimedJoinThread thread;
+  thread.start([&stop]() {
+    while (!stop) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+
+  stop = true;
+  EXPECT_TRUE(thread.joinUntil(Clock::now() + std::chrono::milliseconds(100)));
+  EXPECT_FALSE(thread.joinable());
+  EXPECT_TRUE(thread.finished());
+}
+
+TEST(TimedJoinThread, ReturnsWithinTimeoutForStuckThread)
+{
+  std::atomic<bool> release{false};
+  TimedJoinThread thread;
+  thread.start([&release]() {
+    while (!release) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+
+  const auto timeout = std::chrono::milliseconds(100);
+  const auto start = Clock::now();
+  EXPECT_FALSE(thread.joinUntil(start + timeout));
+  const auto elapsed = Clock::now() - start;
+
+  EXPECT_GE(elapsed, timeout);
+  EXPECT_LT(elapsed, timeout + kSlack);
+  EXPECT_FALSE(thread.joinable());
+  EXPECT_FALSE(thread.finished());
+
+  // 分离后仍可观察到线程退出
+  release = true;
+  waitUntilFinished(thread);
+  EXPECT_TRUE(thread.finished());
+}
+
+TEST(TimedJoinThread, SharedDeadlineBoundsSeveralThreads)
+{
+  std::atomic<bool> release{false};
+  TimedJoinThread threads[3];
+  for (auto & thread : threads) {
+    thread.start([&release]() {
+      while (!release) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    });
+  }
+
+  const auto timeout = std::chrono::milliseconds(100);
+  const auto start = Clock::now();
+  const auto deadline = start + timeout;
+  for (auto & thread : threads) {
+    EXPECT_FALSE(thread.joinUntil(deadline));
+  }
+  EXPECT_LT(Clock::now() - start, timeout + kSlack);
+
+  release = true;
+  for (auto & thread : threads) {
+    waitUntilFinished(thread);
+  }
+}
+
+TEST(TimedJoinThread, NotStartedIsFinished)
+{
+  TimedJoinThread thread;
+  EXPECT_FALSE(thread.joinable());
+  EXPECT_TRUE(thread.finished());
+  EXPECT_TRUE(thread.joinUntil(Clock::now()));
+}